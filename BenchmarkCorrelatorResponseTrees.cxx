@@ -0,0 +1,140 @@
+/// ---------------------------------------------------------------------------
+/*! \file   BenchmarkCorrelatorResponseTrees.cxx
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Use this to compare how fast a downstream
+ *  reader (e.g. the folder) can read back the
+ *  members it needs from a legacy vs. a native
+ *  response tree.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef BENCHMARKCORRELATORRESPONSETREES_CXX
+#define BENCHMARKCORRELATORRESPONSETREES_CXX
+
+// standard c includes
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+// root includes
+#include <TFile.h>
+#include <TTree.h>
+#include <TStopwatch.h>
+
+// load libraries
+R__LOAD_LIBRARY(libscorrelatorutilities.so)
+R__LOAD_LIBRARY(libscorrelatorresponsemaker.so)
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+// ----------------------------------------------------------------------------
+//! Read back only some branches of a response tree
+// ----------------------------------------------------------------------------
+/*! Every branch is switched off except those listed,
+ *  which are then read for each entry (into buffers
+ *  ROOT allocates itself). Prints the time taken and
+ *  the no. of bytes read from the file.
+ */
+bool TimeReadBack(
+  const string label,
+  const string fileName,
+  const string treeName,
+  const vector<string>& branches,
+  const int64_t nMaxEntries
+) {
+
+  TFile* file = TFile::Open(fileName.data(), "read");
+  if (!file || file -> IsZombie()) {
+    cerr << "PANIC: couldn't open " << fileName << "!" << endl;
+    return false;
+  }
+
+  TTree* tree = NULL;
+  file -> GetObject(treeName.data(), tree);
+  if (!tree) {
+    cerr << "PANIC: couldn't grab tree " << treeName << " from " << fileName << "!" << endl;
+    return false;
+  }
+
+  // switch on only the branches needed
+  tree -> SetBranchStatus("*", false);
+  for (const string& branch : branches) {
+    tree -> SetBranchStatus(branch.data(), true);
+  }
+
+  // and read them back
+  const int64_t nEntries  = (nMaxEntries > 0) ? min(nMaxEntries, tree -> GetEntries()) : tree -> GetEntries();
+  const int64_t bytesInit = file -> GetBytesRead();
+
+  TStopwatch watch;
+  watch.Start();
+  int64_t nBytes = 0;
+  for (int64_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+    nBytes += tree -> GetEntry(iEntry);
+  }
+  watch.Stop();
+
+  const double realTime = watch.RealTime();
+  cout << "    " << label << ":\n"
+       << "      entries read     = " << nEntries << "\n"
+       << "      real/cpu time    = " << realTime << " / " << watch.CpuTime() << " s\n"
+       << "      entries per sec  = " << ((realTime > 0.) ? (nEntries / realTime) : 0.) << "\n"
+       << "      bytes unpacked   = " << nBytes << "\n"
+       << "      bytes from file  = " << (file -> GetBytesRead() - bytesInit)
+       << endl;
+
+  file -> Close();
+  return true;
+
+}  // end 'TimeReadBack(string, string, string, vector<string>&, int64_t)'
+
+
+
+// macro body -----------------------------------------------------------------
+
+/*! The default branches are what the folder needs:
+ *  jet pt and cst pt, eta, phi for truth and reco.
+ *  Native members are named after the data members
+ *  of Types::JetInfo and Types::CstInfo.
+ */
+void BenchmarkCorrelatorResponseTrees(
+  const string legacyFile = "legacy.root",
+  const string nativeFile = "native.root",
+  const string treeName = "ResponseTree",
+  const int64_t nMaxEntries = 0,
+  const vector<string> legacyBranches = {
+    "JetTruePt",  "JetRecoPt",
+    "CstTruePt",  "CstRecoPt",
+    "CstTrueEta", "CstRecoEta",
+    "CstTruePhi", "CstRecoPhi"
+  },
+  const vector<string> nativeBranches = {
+    "JetTrue.pt",  "JetReco.pt",
+    "CstOffsets",
+    "CstTrue.pt",  "CstReco.pt",
+    "CstTrue.eta", "CstReco.eta",
+    "CstTrue.phi", "CstReco.phi"
+  }
+) {
+
+  cout << "\n  Benchmarking response tree read-back..." << endl;
+
+  const bool isLegacyRead = TimeReadBack("legacy", legacyFile, treeName, legacyBranches, nMaxEntries);
+  const bool isNativeRead = TimeReadBack("native", nativeFile, treeName, nativeBranches, nMaxEntries);
+  if (!isLegacyRead || !isNativeRead) {
+    exit(EXIT_FAILURE);
+  }
+
+  cout << "  Finished benchmark!\n" << endl;
+  return;
+
+}
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -32,6 +32,7 @@ namespace CorrelatorResponseMakerOptions {
 
   // io options
   const string sOutFile("test.root");
+  const string sShardStem("test_shard");
   const vector<string> sInFiles = {
     "/sphenix/tg/tg01/jets/danderson/eec/SCorrelatorJetTreeMakerOutput/test/testJob_outputData_CorrelatorJetTree_00000.root",
     "/sphenix/tg/tg01/jets/danderson/eec/SCorrelatorJetTreeMakerOutput/test/testJob_outputData_CorrelatorJetTree_00000.root"
@@ -59,7 +60,9 @@ namespace CorrelatorResponseMakerOptions {
   // --------------------------------------------------------------------------
   SCorrelatorResponseMakerConfig GetConfig(
     const bool doBatch = false,
-    const int verbose = verbosity
+    const int verbose = verbosity,
+    const uint32_t iShard = 0,
+    const uint32_t nShards = 1
   ) {
 
     // TODO simplify options!
@@ -76,9 +79,16 @@ namespace CorrelatorResponseMakerOptions {
       .jetMatchQtRange   = qtJetMatchRange,
       .jetMatchDrRange   = drJetMatchRange
     };
+
+    // if sharding, give each shard its own output
+    cfg.iShard  = iShard;
+    cfg.nShards = nShards;
+    if (nShards > 1) {
+      cfg.outFileName = sShardStem + to_string(iShard) + ".root";
+    }
     return cfg;
 
-  }  // end 'GetRecoConfig(vector<string>, string, int)'
+  }  // end 'GetRecoConfig(vector<string>, string, int, uint32_t, uint32_t)'
 
 }  // end CorrelatorResponseMakerOptions namespace
 
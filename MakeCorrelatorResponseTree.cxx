@@ -31,14 +31,22 @@ using namespace std;
 
 // macro body -----------------------------------------------------------------
 
-void MakeCorrelatorResponseTree(const bool doBatch = false, const int verbosity = 0) {
+void MakeCorrelatorResponseTree(
+  const bool doBatch = false,
+  const int verbosity = 0,
+  const uint32_t iShard = 0,
+  const uint32_t nShards = 1
+) {
 
   // get module configuration
-  SCorrelatorResponseMakerConfig cfg = CorrelatorResponseMakerOptions::GetConfig(doBatch, verbosity);
+  SCorrelatorResponseMakerConfig cfg = CorrelatorResponseMakerOptions::GetConfig(doBatch, verbosity, iShard, nShards);
 
   // construct correlator response tree
   SCorrelatorResponseMaker* maker = new SCorrelatorResponseMaker(cfg);
-  maker -> Init();
+  if (!maker -> Init()) {
+    delete maker;
+    exit(EXIT_FAILURE);
+  }
   maker -> Analyze();
   maker -> End();
   return;
@@ -5,13 +5,41 @@
 # @date   05.16.2024
 #
 # Short script to run the 'MakeCorrelatorResponseTree.cxx' macro.
+#
+# Usage:
+#   ./MakeCorrelatorResponseTree.rb          -- run in one process
+#   ./MakeCorrelatorResponseTree.rb condor   -- submit to condor
+#   ./MakeCorrelatorResponseTree.rb local N  -- run N shards as local
+#                                               processes and merge
 # -----------------------------------------------------------------------------
 
+# shard output stem and merged output
+# (should match CorrelatorResponseMakerOptions.h)
+shard_stem = "test_shard"
+shard_list = "shards.list"
+merged     = "test.root"
+
 if ARGV[0] == "condor"
-  exec("condor_submit MakeCorrelatorResponseTree.job")
+  exec("condor_submit MakeCorrelatorResponseTreeOnCondor.job")
+elsif ARGV[0] == "local"
+
+  # launch one process per shard
+  nShards = (ARGV[1] || 4).to_i
+  pids    = (0...nShards).map do |iShard|
+    spawn("root -b -q 'MakeCorrelatorResponseTree.cxx(true, 0, #{iShard}, #{nShards})'")
+  end
+
+  # wait for all shards to finish
+  statuses = pids.map { |pid| Process.wait2(pid)[1] }
+  unless statuses.all?(&:success?)
+    abort("ERROR: at least one shard failed! Not merging.")
+  end
+
+  # merge shards
+  File.write(shard_list, (0...nShards).map { |iShard| "#{shard_stem}#{iShard}.root" }.join("\n") + "\n")
+  exec("root -b -q 'MergeCorrelatorResponseTrees.cxx(\"#{shard_list}\", \"#{merged}\")'")
 else
   exec("root -b -q MakeCorrelatorResponseTree.cxx")
 end
 
 # end -------------------------------------------------------------------------
-
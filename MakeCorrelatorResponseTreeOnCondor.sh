@@ -14,7 +14,11 @@ export HOME=/sphenix/u/${LOGNAME}
 source /opt/sphenix/core/bin/sphenix_setup.sh
 printenv
 
+# grab shard (defaults to whole input)
+iShard=${1:-0}
+nShards=${2:-1}
+
 # run macro
-root -b -q "MakeCorrealtorResponseTree.cxx(true)"
+root -b -q "MakeCorrelatorResponseTree.cxx(true, 0, ${iShard}, ${nShards})"
 
 # end -------------------------------------------------------------------------
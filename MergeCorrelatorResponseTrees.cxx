@@ -0,0 +1,63 @@
+/// ---------------------------------------------------------------------------
+/*! \file   MergeCorrelatorResponseTrees.cxx
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Use this to merge the outputs of several
+ *  SCorrelatorResponseMaker shards (or output
+ *  chunks) into a single response tree.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef MERGECORRELATORRESPONSETREES_CXX
+#define MERGECORRELATORRESPONSETREES_CXX
+
+// standard c includes
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+// module definition
+#include <scorrelatorresponsemaker/SCorrelatorResponseMaker.h>
+
+// load libraries
+R__LOAD_LIBRARY(libscorrelatorutilities.so)
+R__LOAD_LIBRARY(libscorrelatorresponsemaker.so)
+
+// make common namespaces implicit
+using namespace std;
+using namespace SColdQcdCorrelatorAnalysis;
+
+
+
+// macro body -----------------------------------------------------------------
+
+void MergeCorrelatorResponseTrees(
+  const string inList = "shards.list",
+  const string outFile = "test.root",
+  const bool requireTotal = true
+) {
+
+  // read list of shards
+  vector<string> inFiles;
+  ifstream list(inList.data());
+  string line;
+  while (getline(list, line)) {
+    if (!line.empty()) inFiles.push_back(line);
+  }
+
+  // merge shards
+  SCorrelatorResponseMakerMerger merger;
+  merger.requireTotal = requireTotal;
+
+  const bool isMerged = merger.Merge(inFiles, outFile);
+  if (!isMerged) {
+    exit(EXIT_FAILURE);
+  }
+  return;
+
+}
+
+#endif
+
+// end ------------------------------------------------------------------------
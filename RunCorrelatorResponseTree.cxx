@@ -0,0 +1,57 @@
+/// ---------------------------------------------------------------------------
+/*! \file   RunCorrelatorResponseTree.cxx
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Use this to run the SCorrelatorResponseMaker
+ *  class in several processes on one node.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef RUNCORRELATORRESPONSETREE_CXX
+#define RUNCORRELATORRESPONSETREE_CXX
+
+// standard c includes
+#include <string>
+#include <cstdlib>
+#include <utility>
+// module definition
+#include <scorrelatorresponsemaker/SCorrelatorResponseMakerRunner.h>
+// macro options
+#include "CorrelatorResponseMakerOptions.h"
+
+// load libraries
+R__LOAD_LIBRARY(libscorrelatorutilities.so)
+R__LOAD_LIBRARY(libscorrelatorresponsemaker.so)
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+// macro body -----------------------------------------------------------------
+
+void RunCorrelatorResponseTree(
+  const uint32_t nProcs = 4,
+  const bool doBatch = true,
+  const int verbosity = 0
+) {
+
+  // get module configuration
+  SCorrelatorResponseMakerConfig cfg = CorrelatorResponseMakerOptions::GetConfig(doBatch, verbosity);
+
+  // run workers and merge output
+  SCorrelatorResponseMakerRunner runner;
+  runner.nProcs = nProcs;
+
+  const bool isDone = runner.Run(cfg);
+  if (!isDone) {
+    exit(EXIT_FAILURE);
+  }
+  return;
+
+}
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+/// ---------------------------------------------------------------------------
+/*! \file   TestCorrelatorResponseAssigner.cxx
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Use this to check the sparse assignment solver
+ *  used for event-wide jet matching against a brute
+ *  force search, on every small matrix with a few
+ *  benefit levels and on random larger ones.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef TESTCORRELATORRESPONSEASSIGNER_CXX
+#define TESTCORRELATORRESPONSEASSIGNER_CXX
+
+// standard c includes
+#include <cmath>
+#include <random>
+#include <vector>
+#include <iostream>
+// module definition
+#include <scorrelatorresponsemaker/SCorrelatorResponseMaker.h>
+
+// load libraries
+R__LOAD_LIBRARY(libscorrelatorutilities.so)
+R__LOAD_LIBRARY(libscorrelatorresponsemaker.so)
+
+// make common namespaces implicit
+using namespace std;
+using namespace SColdQcdCorrelatorAnalysis;
+
+// a benefit matrix, where 0 marks a pair which isn't allowed
+typedef vector<vector<double>> Benefits;
+
+
+
+// ----------------------------------------------------------------------------
+//! Find best total benefit by trying every assignment
+// ----------------------------------------------------------------------------
+/*! Each row may be left unassigned.
+ */
+double FindBestByBruteForce(const Benefits& benefits, const size_t iRow, vector<bool>& isColUsed) {
+
+  if (iRow == benefits.size()) return 0.;
+
+  // leave row unassigned
+  double best = FindBestByBruteForce(benefits, iRow + 1, isColUsed);
+
+  // or give it any free column it's allowed
+  for (size_t iCol = 0; iCol < isColUsed.size(); ++iCol) {
+    if (isColUsed[iCol] || (benefits[iRow][iCol] <= 0.)) continue;
+    isColUsed[iCol] = true;
+    best = max(best, benefits[iRow][iCol] + FindBestByBruteForce(benefits, iRow + 1, isColUsed));
+    isColUsed[iCol] = false;
+  }
+  return best;
+
+}  // end 'FindBestByBruteForce(Benefits&, size_t, vector<bool>&)'
+
+
+
+// ----------------------------------------------------------------------------
+//! Solve a matrix and check the result against brute force
+// ----------------------------------------------------------------------------
+/*! The assignment must only use allowed pairs, use each
+ *  column at most once, and reach the best total.
+ */
+bool IsSolvedCorrectly(const Benefits& benefits, const size_t nCols, SCorrelatorResponseMakerAssigner& assigner) {
+
+  assigner.Reset(nCols);
+  for (const vector<double>& row : benefits) {
+    assigner.AddRow();
+    for (size_t iCol = 0; iCol < nCols; ++iCol) {
+      if (row[iCol] > 0.) assigner.AddEdge(iCol, row[iCol]);
+    }
+  }
+  assigner.Solve();
+
+  double       total = 0.;
+  vector<bool> isColUsed(nCols, false);
+  for (size_t iRow = 0; iRow < benefits.size(); ++iRow) {
+    const int32_t iCol = assigner.GetCol(iRow);
+    if (iCol < 0) continue;
+    if ((iCol >= (int32_t) nCols) || isColUsed[iCol] || (benefits[iRow][iCol] <= 0.)) return false;
+    isColUsed[iCol] = true;
+    total += benefits[iRow][iCol];
+  }
+
+  vector<bool> isColTried(nCols, false);
+  return (fabs(total - FindBestByBruteForce(benefits, 0, isColTried)) < 1e-9);
+
+}  // end 'IsSolvedCorrectly(Benefits&, size_t, SCorrelatorResponseMakerAssigner&)'
+
+
+
+// macro body -----------------------------------------------------------------
+
+/*! First tries every matrix of up to 3 x 3 whose pairs
+ *  are either not allowed or have one of a few benefits
+ *  (so that ties are covered), then nRandom matrices of
+ *  up to 6 x 6 with benefits drawn at random. Returns
+ *  whether the solver got all of them right.
+ */
+bool TestCorrelatorResponseAssigner(const uint32_t nRandom = 5000) {
+
+  cout << "\n  Testing sparse assignment solver..." << endl;
+
+  SCorrelatorResponseMakerAssigner assigner;
+  const vector<double>             levels = {0., 0.25, 0.5, 1.};
+
+  // try every small matrix
+  //   - n.b. each matrix is numbered in base (no. of
+  //     levels), one digit per pair
+  uint64_t nSmall    = 0;
+  uint64_t nSmallBad = 0;
+  for (size_t nRows = 1; nRows <= 3; ++nRows) {
+    for (size_t nCols = 1; nCols <= 3; ++nCols) {
+
+      const uint64_t nPairs    = nRows * nCols;
+      const uint64_t nMatrices = (uint64_t) pow(levels.size(), nPairs);
+      for (uint64_t iMatrix = 0; iMatrix < nMatrices; ++iMatrix) {
+
+        Benefits benefits(nRows, vector<double>(nCols, 0.));
+        uint64_t digits = iMatrix;
+        for (uint64_t iPair = 0; iPair < nPairs; ++iPair) {
+          benefits[iPair / nCols][iPair % nCols] = levels[digits % levels.size()];
+          digits /= levels.size();
+        }
+
+        ++nSmall;
+        if (!IsSolvedCorrectly(benefits, nCols, assigner)) {
+          cerr << "WARNING: matrix " << iMatrix << " of " << nRows << " x " << nCols << " solved wrong!" << endl;
+          ++nSmallBad;
+        }
+      }
+    }
+  }
+  cout << "    small matrices: " << (nSmall - nSmallBad) << " of " << nSmall << " solved right" << endl;
+
+  // then try random larger ones
+  minstd_rand                        rng(nRandom);
+  uniform_int_distribution<uint32_t> drawSize(0, 6);
+  uniform_real_distribution<double>  drawUnit(0., 1.);
+
+  uint64_t nRandomBad = 0;
+  for (uint32_t iRandom = 0; iRandom < nRandom; ++iRandom) {
+
+    const size_t nRows    = drawSize(rng);
+    const size_t nCols    = drawSize(rng);
+    const double fracPair = drawUnit(rng);
+
+    Benefits benefits(nRows, vector<double>(nCols, 0.));
+    for (vector<double>& row : benefits) {
+      for (double& benefit : row) {
+        if (drawUnit(rng) < fracPair) benefit = drawUnit(rng);
+      }
+    }
+
+    if (!IsSolvedCorrectly(benefits, nCols, assigner)) {
+      cerr << "WARNING: random matrix " << iRandom << " (" << nRows << " x " << nCols << ") solved wrong!" << endl;
+      ++nRandomBad;
+    }
+  }
+  cout << "    random matrices: " << (nRandom - nRandomBad) << " of " << nRandom << " solved right" << endl;
+
+  const bool isGood = ((nSmallBad + nRandomBad) == 0);
+  cout << "  " << (isGood ? "Solver agrees with brute force." : "Solver disagrees with brute force!") << "\n" << endl;
+  return isGood;
+
+}
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,143 @@
+/// ---------------------------------------------------------------------------
+/*! \file   TestCorrelatorResponsePrecision.cxx
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Use this to check that packing output fields at
+ *  reduced precision stays within its error bounds.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef TESTCORRELATORRESPONSEPRECISION_CXX
+#define TESTCORRELATORRESPONSEPRECISION_CXX
+
+// standard c includes
+#include <cmath>
+#include <vector>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+// module definition
+#include <scorrelatorresponsemaker/SCorrelatorResponseMaker.h>
+
+// load libraries
+R__LOAD_LIBRARY(libscorrelatorutilities.so)
+R__LOAD_LIBRARY(libscorrelatorresponsemaker.so)
+
+// make common namespaces implicit
+using namespace std;
+using namespace SColdQcdCorrelatorAnalysis;
+
+
+
+// ----------------------------------------------------------------------------
+//! Worst packing of a sweep of values
+// ----------------------------------------------------------------------------
+struct PackingSweep {
+
+  double   maxRelDev = 0.;
+  uint64_t nDirty    = 0;
+
+};  // end PackingSweep
+
+
+
+// ----------------------------------------------------------------------------
+//! Sweep values over several orders of magnitude through a precision
+// ----------------------------------------------------------------------------
+/*! Values are log-spaced from 1e-10 to 1e10, with both
+ *  signs, and include exact halfway points between the
+ *  values kept, so that rounding is exercised. Records
+ *  the largest relative deviation and how many packed
+ *  values have any of their dropped bits set.
+ */
+PackingSweep SweepPrecision(const SCorrelatorResponseMakerPrecision& precision, const uint32_t nVals) {
+
+  const uint32_t nDrop = 23 - min(precision.nBits, (uint32_t) 23);
+
+  PackingSweep sweep;
+  for (uint32_t iVal = 0; iVal < nVals; ++iVal) {
+
+    // get value and a halfway point next to it
+    const double exponent = -10. + ((20. * iVal) / max(nVals - 1, (uint32_t) 1));
+    const double value    = pow(10., exponent) * (((iVal % 2) == 0) ? 1. : -1.);
+    const double halfway  = value * (1. + ldexp(1., -(int) (23 - nDrop) - 1));
+
+    for (const double test : {value, halfway}) {
+      const float packed = precision.Pack(test);
+
+      uint32_t bits = 0;
+      memcpy(&bits, &packed, sizeof(bits));
+      if ((nDrop > 0) && ((bits & ((1u << nDrop) - 1)) != 0)) ++sweep.nDirty;
+
+      sweep.maxRelDev = max(sweep.maxRelDev, fabs((packed - test) / test));
+    }
+  }
+  return sweep;
+
+}  // end 'SweepPrecision(SCorrelatorResponseMakerPrecision&, uint32_t)'
+
+
+
+// macro body -----------------------------------------------------------------
+
+/*! For each no. of mantissa bits kept, the largest
+ *  relative deviation must be within half of the lowest
+ *  kept bit (plus float rounding), and the dropped bits
+ *  must be zero. Also checks which precisions are
+ *  flagged as invalid, and that fields which don't
+ *  exist are rejected. Returns whether everything
+ *  passed.
+ */
+bool TestCorrelatorResponsePrecision(const uint32_t nVals = 50000) {
+
+  cout << "\n  Testing reduced-precision packing..." << endl;
+  cout << "    bits   max rel. dev.   bound           dirty" << endl;
+
+  bool isGood = true;
+  for (const uint32_t nBits : {1, 2, 8, 12, 16, 22, 23, 32}) {
+
+    SCorrelatorResponseMakerPrecision precision;
+    precision.mode  = SCorrelatorResponseMakerPrecision::Float16;
+    precision.nBits = nBits;
+
+    const uint32_t     nKept = min(nBits, (uint32_t) 23);
+    const double       bound = ldexp(1., -(int) (nKept + 1)) + ldexp(1., -24);
+    const PackingSweep sweep = SweepPrecision(precision, nVals);
+    const bool         isOK  = (sweep.maxRelDev <= bound) && (sweep.nDirty == 0);
+    cout << "    " << setw(4) << nBits
+         << "   " << scientific << setprecision(3) << sweep.maxRelDev
+         << "       " << bound << defaultfloat
+         << "       " << sweep.nDirty
+         << (isOK ? "" : "  <-- failed")
+         << endl;
+    isGood &= isOK;
+  }
+
+  // check invalid precisions and fields are caught
+  //   - n.b. only packing to zero bits is invalid
+  SCorrelatorResponseMakerPrecision zeroBits;
+  zeroBits.mode  = SCorrelatorResponseMakerPrecision::Float16;
+  zeroBits.nBits = 0;
+
+  SCorrelatorResponseMakerPrecision floats;
+  floats.mode  = SCorrelatorResponseMakerPrecision::Float;
+  floats.nBits = 0;
+
+  const bool isZeroCaught  = !zeroBits.IsValid();
+  const bool isFloatOK     = floats.IsValid();
+  const bool isFieldCaught = !SCorrelatorResponseMakerLegacyOutput::CheckPrecisions({{"jetPtt", floats}});
+  cout << "    0 bits flagged invalid: " << (isZeroCaught ? "yes" : "NO") << "\n"
+       << "    floats flagged valid:   " << (isFloatOK ? "yes" : "NO") << "\n"
+       << "    unknown field rejected: " << (isFieldCaught ? "yes" : "NO")
+       << endl;
+  isGood &= (isZeroCaught && isFloatOK && isFieldCaught);
+
+  cout << "  " << (isGood ? "All precisions within bounds." : "Some precisions out of bounds!") << "\n" << endl;
+  return isGood;
+
+}
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,224 @@
+/// ---------------------------------------------------------------------------
+/*! \file   ValidateCorrelatorResponsePrecision.cxx
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Use this to check how far a (legacy) response
+ *  tree written at reduced precision deviates from
+ *  the same tree written with doubles.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef VALIDATECORRELATORRESPONSEPRECISION_CXX
+#define VALIDATECORRELATORRESPONSEPRECISION_CXX
+
+// standard c includes
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+// root includes
+#include <TFile.h>
+#include <TTree.h>
+#include <TBranch.h>
+
+// load libraries
+R__LOAD_LIBRARY(libscorrelatorutilities.so)
+R__LOAD_LIBRARY(libscorrelatorresponsemaker.so)
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+// ----------------------------------------------------------------------------
+//! Deviations of one branch
+// ----------------------------------------------------------------------------
+struct Deviation {
+  double  maxAbs = 0.;
+  double  maxRel = 0.;
+  int64_t nVals  = 0;
+  int64_t nBad   = 0;  // values with a different no. of entries
+};
+
+
+
+// ----------------------------------------------------------------------------
+//! Compare a value to its reference
+// ----------------------------------------------------------------------------
+void Compare(const double ref, const double test, Deviation& dev) {
+
+  const double abs = fabs(test - ref);
+  dev.maxAbs = max(dev.maxAbs, abs);
+  if (ref != 0.) {
+    dev.maxRel = max(dev.maxRel, abs / fabs(ref));
+  }
+  ++dev.nVals;
+  return;
+
+}  // end 'Compare(double, double, Deviation&)'
+
+
+
+// ----------------------------------------------------------------------------
+//! Compare a branch of (nested) vectors entry by entry
+// ----------------------------------------------------------------------------
+template <typename TTest> Deviation CompareFlat(TTree* ref, TTree* test, const string& name, const int64_t nEntries) {
+
+  // only read the branch being compared
+  ref  -> SetBranchStatus("*", 0);
+  test -> SetBranchStatus("*", 0);
+  ref  -> SetBranchStatus(name.data(), 1);
+  test -> SetBranchStatus(name.data(), 1);
+
+  vector<double>* refVals  = NULL;
+  vector<TTest>*  testVals = NULL;
+  ref  -> SetBranchAddress(name.data(), &refVals);
+  test -> SetBranchAddress(name.data(), &testVals);
+
+  Deviation dev;
+  for (int64_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+    ref  -> GetEntry(iEntry);
+    test -> GetEntry(iEntry);
+    if (refVals -> size() != testVals -> size()) {
+      ++dev.nBad;
+      continue;
+    }
+    for (size_t iVal = 0; iVal < refVals -> size(); ++iVal) {
+      Compare((*refVals)[iVal], (*testVals)[iVal], dev);
+    }
+  }
+  ref  -> ResetBranchAddresses();
+  test -> ResetBranchAddresses();
+  return dev;
+
+}  // end 'CompareFlat(TTree*, TTree*, string&, int64_t)'
+
+template <typename TTest> Deviation CompareNested(TTree* ref, TTree* test, const string& name, const int64_t nEntries) {
+
+  // only read the branch being compared
+  ref  -> SetBranchStatus("*", 0);
+  test -> SetBranchStatus("*", 0);
+  ref  -> SetBranchStatus(name.data(), 1);
+  test -> SetBranchStatus(name.data(), 1);
+
+  vector<vector<double>>* refVals  = NULL;
+  vector<vector<TTest>>*  testVals = NULL;
+  ref  -> SetBranchAddress(name.data(), &refVals);
+  test -> SetBranchAddress(name.data(), &testVals);
+
+  Deviation dev;
+  for (int64_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+    ref  -> GetEntry(iEntry);
+    test -> GetEntry(iEntry);
+    if (refVals -> size() != testVals -> size()) {
+      ++dev.nBad;
+      continue;
+    }
+    for (size_t iJet = 0; iJet < refVals -> size(); ++iJet) {
+      if ((*refVals)[iJet].size() != (*testVals)[iJet].size()) {
+        ++dev.nBad;
+        continue;
+      }
+      for (size_t iVal = 0; iVal < (*refVals)[iJet].size(); ++iVal) {
+        Compare((*refVals)[iJet][iVal], (*testVals)[iJet][iVal], dev);
+      }
+    }
+  }
+  ref  -> ResetBranchAddresses();
+  test -> ResetBranchAddresses();
+  return dev;
+
+}  // end 'CompareNested(TTree*, TTree*, string&, int64_t)'
+
+
+
+// macro body -----------------------------------------------------------------
+
+/*! Every vector-of-double branch of the reference tree
+ *  is compared against the branch of the same name in
+ *  the test tree (stored as doubles or floats). Returns
+ *  with a failure if any relative deviation is above
+ *  maxRelDev (if > 0).
+ */
+void ValidateCorrelatorResponsePrecision(
+  const string refFile = "double.root",
+  const string testFile = "reduced.root",
+  const string treeName = "ResponseTree",
+  const double maxRelDev = 0.
+) {
+
+  cout << "\n  Validating reduced-precision response tree..." << endl;
+
+  // open files and grab trees
+  TFile* fRef  = TFile::Open(refFile.data(), "read");
+  TFile* fTest = TFile::Open(testFile.data(), "read");
+  if (!fRef || !fTest) {
+    cerr << "PANIC: couldn't open input files!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  TTree* tRef  = NULL;
+  TTree* tTest = NULL;
+  fRef  -> GetObject(treeName.data(), tRef);
+  fTest -> GetObject(treeName.data(), tTest);
+  if (!tRef || !tTest) {
+    cerr << "PANIC: couldn't grab trees!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  const int64_t nEntries = min(tRef -> GetEntries(), tTest -> GetEntries());
+  if (tRef -> GetEntries() != tTest -> GetEntries()) {
+    cerr << "WARNING: trees have different no. of entries! Comparing first " << nEntries << "." << endl;
+  }
+
+  // compare each branch of doubles
+  bool isGood = true;
+  for (TObject* obj : *(tRef -> GetListOfBranches())) {
+
+    TBranch*     refBranch  = (TBranch*) obj;
+    TBranch*     testBranch = tTest -> GetBranch(refBranch -> GetName());
+    const string name       = refBranch -> GetName();
+    const string refType    = refBranch -> GetClassName();
+    if (!testBranch) continue;
+    if ((refType != "vector<double>") && (refType != "vector<vector<double> >")) continue;
+
+    const string testType = testBranch -> GetClassName();
+    Deviation    dev;
+    if      (testType == "vector<double>")          dev = CompareFlat<double>(tRef, tTest, name, nEntries);
+    else if (testType == "vector<float>")           dev = CompareFlat<float>(tRef, tTest, name, nEntries);
+    else if (testType == "vector<vector<double> >") dev = CompareNested<double>(tRef, tTest, name, nEntries);
+    else if (testType == "vector<vector<float> >")  dev = CompareNested<float>(tRef, tTest, name, nEntries);
+    else continue;
+
+    const bool isOver = (maxRelDev > 0.) && (dev.maxRel > maxRelDev);
+    cout << "    " << name << " (" << testType << "):\n"
+         << "      values compared  = " << dev.nVals << "\n"
+         << "      max abs/rel dev  = " << dev.maxAbs << " / " << dev.maxRel
+         << (isOver ? "  <-- over limit" : "")
+         << endl;
+    if (dev.nBad > 0) {
+      cerr << "WARNING: " << dev.nBad << " entries of " << name << " have different sizes!" << endl;
+    }
+    isGood &= (!isOver && (dev.nBad == 0));
+  }
+
+  // report file sizes
+  cout << "    file sizes: " << fRef -> GetSize() << " (double) vs. " << fTest -> GetSize() << " (reduced) bytes" << endl;
+
+  fRef  -> Close();
+  fTest -> Close();
+  if (!isGood) {
+    exit(EXIT_FAILURE);
+  }
+
+  cout << "  Finished validation!\n" << endl;
+  return;
+
+}
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -19,6 +19,12 @@ copy_to   = "/sphenix/user/danderson/sphenix/analysis/EnergyCorrelatorsJets/Cold
 to_copy = [
   "README.md",
   "MakeCorrelatorResponseTree.cxx",
+  "MergeCorrelatorResponseTrees.cxx",
+  "RunCorrelatorResponseTree.cxx",
+  "BenchmarkCorrelatorResponseTrees.cxx",
+  "ValidateCorrelatorResponsePrecision.cxx",
+  "TestCorrelatorResponseAssigner.cxx",
+  "TestCorrelatorResponsePrecision.cxx",
   "MakeCorrelatorResponseTree.rb",
   "MakeCorrelatorResponseTreeOnCondor.sh",
   "MakeCorrelatorResponseTreeOnCondor.job",
@@ -29,9 +35,28 @@ to_copy = [
   "src/SCorrelatorResponseMaker.h",
   "src/SCorrelatorResponseMaker.ana.h",
   "src/SCorrelatorResponseMaker.sys.h",
+  "src/SCorrelatorResponseMakerArena.h",
+  "src/SCorrelatorResponseMakerPrecision.h",
+  "src/SCorrelatorResponseMakerBins.h",
   "src/SCorrelatorResponseMakerInput.h",
+  "src/SCorrelatorResponseMakerBatch.h",
+  "src/SCorrelatorResponseMakerMatches.h",
+  "src/SCorrelatorResponseMakerTables.h",
+  "src/SCorrelatorResponseMakerIntersect.h",
+  "src/SCorrelatorResponseMakerCache.h",
+  "src/SCorrelatorResponseMakerDispatch.h",
+  "src/SCorrelatorResponseMakerAssign.h",
+  "src/SCorrelatorResponseMakerKDTree.h",
   "src/SCorrelatorResponseMakerOutput.h",
+  "src/SCorrelatorResponseMakerSparseReader.h",
+  "src/SCorrelatorResponseMakerShards.h",
+  "src/SCorrelatorResponseMakerIndex.h",
+  "src/SCorrelatorResponseMakerCheckpoint.h",
+  "src/SCorrelatorResponseMakerRunner.h",
   "src/SCorrelatorResponseMakerConfig.h",
+  "src/SCorrelatorResponseMakerMemory.h",
+  "src/SCorrelatorResponseMakerAllocHook.cc",
+  "src/SCorrelatorResponseMakerStats.h",
   "src/SCorrelatorResponseMakerLinkDef.h",
   "src/autogen.sh",
   "src/configure.ac",
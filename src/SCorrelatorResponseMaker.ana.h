@@ -36,149 +36,740 @@ namespace SColdQcdCorrelatorAnalysis {
     const pair<uint64_t, uint64_t> nEvts     = {nTrueEvts, nRecoEvts};
     PrintMessage(6, 0, nEvts);
 
+    // get range of entries to process
+    //   - n.b. if resuming, the current output chunk
+    //     already starts where it should
+    SCorrelatorResponseMakerRange range;
+    if (!GetEntryRange(nTrueEvts, range)) return;
+
+    const pair<uint64_t, uint64_t> nProc = {range.last - range.first, nRecoEvts};
+    if (!m_isResumed) m_outRange.first = range.first;
+    m_outRange.last  = range.last;
+    m_outRange.total = range.total;
+    PrintMessage(11);
+
     // loop over true events
-    uint64_t nTrueBytes = 0;
-    uint64_t nRecoBytes = 0;
-    for (uint64_t iTrueEvt = 0; iTrueEvt < nTrueEvts; iTrueEvt++) {
+    //   - n.b. events are read in batches of batchSize,
+    //     then matched and filled one at a time
+    const uint64_t start      = m_isResumed ? max(range.first, m_resumeEntry) : range.first;
+    const uint64_t batchSize  = max<uint64_t>(m_config.batchSize, 1);
+    const auto     loopStart  = chrono::steady_clock::now();
+    const uint64_t loopAllocs = SCorrelatorResponseMakerMemory::nAllocs;
+    bool           isDone     = false;
+    for (uint64_t iTrueEvt = start; (iTrueEvt < range.last) && !isDone; iTrueEvt += batchSize) {
+
+      // clear previous batch and per-event memory
+      {
+        SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::ResetOut, m_config.doStageTimers);
+        m_batch.Reset();
+        ResetBookkeepers();
+      }
+
+      // read batch
+      const uint64_t stop = min(iTrueEvt + batchSize, range.last);
+      for (uint64_t iBatchEvt = iTrueEvt; iBatchEvt < stop; ++iBatchEvt) {
+        if (!ReadEntry(iBatchEvt, (iBatchEvt - range.first) + 1, nProc)) {
+          isDone = true;
+          break;
+        }
+        m_batch.AddEvent(iBatchEvt, m_trueInput, m_recoInput);
+      }
+
+      // check acceptance and jet windows across batch
+      if (batchSize > 1) {
+        SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::Batch, m_config.doStageTimers);
+        m_batch.Build([this](const Types::JetInfo& jet) {return IsGoodJet(jet);});
+        m_batch.FindPairs(m_config.jetMatchDrRange, m_config.jetMatchQtRange);
+      }
+
+      // loop over events in batch
+      for (m_iBatchEvt = 0; m_iBatchEvt < m_batch.nEvts; ++m_iBatchEvt) {
+
+        // clear output addresses and matches of previous event
+        {
+          SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::ResetOut, m_config.doStageTimers);
+          ResetOutVariables();
+          ResetBookkeepers(false);
+        }
+
+        // match truth to reco jets
+        m_batch.SwapEvent(m_iBatchEvt, m_trueInput, m_recoInput);
+        {
+          SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::Match, m_config.doStageTimers);
+          MatchJets();
+        }
+
+        // fill output tree
+        const uint32_t iChunk = m_iOutChunk;
+        FillTree();
+        m_batch.SwapEvent(m_iBatchEvt, m_trueInput, m_recoInput);
+        ++m_stats.nEvts;
+
+        // checkpoint if needed
+        //   - n.b. also done right after rolling over, so
+        //     that the checkpoint never points to a chunk
+        //     which has been closed
+        const uint64_t iEntry       = m_batch.entries[m_iBatchEvt];
+        const uint64_t nDone        = (iEntry - start) + 1;
+        const bool     isRolledOver = (m_iOutChunk != iChunk);
+        if ((m_config.nEvtsPerCheckpoint > 0) && (isRolledOver || ((nDone % m_config.nEvtsPerCheckpoint) == 0))) {
+          WriteCheckpoint(iEntry + 1);
+        }
+
+        // sample memory usage if needed
+        if (m_config.doMemTracking && (m_config.nEvtsPerMemSample > 0) && ((iEntry % m_config.nEvtsPerMemSample) == 0)) {
+          m_stats.SampleRSS();
+        }
+      }  // end batch event loop
+    }  // end true event loop
+    m_stats.loopTime = chrono::duration<double>(chrono::steady_clock::now() - loopStart).count();
+    m_stats.nAllocs  = SCorrelatorResponseMakerMemory::nAllocs - loopAllocs;
+    PrintMessage(8);
+
+  }  // end 'DoMatching()'
 
-      // load true entry
-      //   - FIXME event loop should go into the top-level analysis method
-      const uint64_t trueEntry = Interfaces::LoadTree(m_inTrueTree, iTrueEvt, m_fTrueCurrent);
-      if (trueEntry < 0) break;
 
-      const uint64_t trueBytes = Interfaces::GetEntry(m_inTrueTree, iTrueEvt);
+
+  // --------------------------------------------------------------------------
+  //! Read truth and reco entries into inputs
+  // --------------------------------------------------------------------------
+  /*! Returns false if either entry couldn't be read,
+   *  in which case the event loop should stop.
+   */
+  bool SCorrelatorResponseMaker::ReadEntry(const uint64_t iEntry, const uint64_t iProc, const pair<uint64_t, uint64_t> nProc) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 2)) {
+      PrintDebug(29);
+    }
+
+    // load true entry
+    //   - FIXME event loop should go into the top-level analysis method
+    {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::ReadTrue, m_config.doStageTimers);
+
+      const int64_t trueEntry = Interfaces::LoadTree(m_inTrueTree, iEntry, m_fTrueCurrent);
+      if (trueEntry < 0) return false;
+
+      const int64_t trueBytes = Interfaces::GetEntry(m_inTrueTree, iEntry);
       if (trueBytes < 0) {
-        PrintError(4, iTrueEvt);
-        break;
+        PrintError(4, iEntry);
+        return false;
       } else {
-        nTrueBytes += trueBytes;
-        PrintMessage(7, iTrueEvt + 1, nEvts);
+        m_stats.nTrueBytes += trueBytes;
+        PrintMessage(7, iProc, nProc);
       }
+    }
+
+    // load reco entry
+    //   - n.b. since this is simulation,
+    //     events are assumed to be 1-to-1
+    {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::ReadReco, m_config.doStageTimers);
 
-      // load reco entry
-      //   - n.b. since this is simulation,
-      //     events are assumed to be 1-to-1
-      const uint64_t recoEntry = Interfaces::LoadTree(m_inRecoTree, iTrueEvt, m_fRecoCurrent);
-      if (recoEntry < 0) break;
+      const int64_t recoEntry = Interfaces::LoadTree(m_inRecoTree, iEntry, m_fRecoCurrent);
+      if (recoEntry < 0) return false;
 
-      const uint64_t recoBytes = Interfaces::GetEntry(m_inRecoTree, iTrueEvt);
+      const int64_t recoBytes = Interfaces::GetEntry(m_inRecoTree, iEntry);
       if (recoBytes < 0) {
-        PrintError(5, iTrueEvt);
-        break;
+        PrintError(5, iEntry);
+        return false;
       } else {
-        nRecoBytes += recoBytes;
+        m_stats.nRecoBytes += recoBytes;
       }
+    }
 
-      // is uing legacy input, fill container
-      if (m_config.isLegacyIO) {
-        m_recoLegacy.SetInput(m_recoInput);
-        m_trueLegacy.SetInput(m_trueInput);
+    // fill containers from branches
+    //   - n.b. malformed entries stop the loop
+    {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::SetInput, m_config.doStageTimers);
+      const bool isRecoGood = m_isLegacyReco
+                            ? m_recoLegacy.SetInput(m_recoInput, m_config.useStoredCstEne)
+                            : m_recoNative.SetInput(m_recoInput);
+      if (!isRecoGood) {
+        PrintError(18, iEntry);
+        return false;
       }
+      const bool isTrueGood = m_isLegacyTrue
+                            ? m_trueLegacy.SetInput(m_trueInput, nullopt, m_config.useStoredCstEne)
+                            : m_trueNative.SetInput(m_trueInput);
+      if (!isTrueGood) {
+        PrintError(17, iEntry);
+        return false;
+      }
+    }
+    return true;
+
+  }  // end 'ReadEntry(uint64_t, uint64_t, pair<uint64_t, uint64_t>)'
+
+
 
-      // clear output addresses
-      ResetOutVariables();
+  // --------------------------------------------------------------------------
+  //! Match truth to reco jets in current event
+  // --------------------------------------------------------------------------
+  /*! Produces a match record for each good truth jet,
+   *  holding the indices of the best-matching reco jet
+   *  and of the reco constituents matched to each good
+   *  truth constituent. The reco side is cached once
+   *  per event, and constituents are matched by a
+   *  merge-join of the ID-sorted truth and reco lists.
+   *  Candidate reco jets are searched in order of the
+   *  best fraction they could match, so that the search
+   *  can stop early. If matching globally, the overlaps
+   *  of all candidates are collected instead and the
+   *  jets are assigned once every truth jet is done.
+   */
+  void SCorrelatorResponseMaker::MatchJets() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 2)) {
+      PrintDebug(18);
+    }
+
+    // pick how to index reco candidates based on event size
+    size_t nRecoCsts = 0;
+    for (const auto& csts : m_recoInput.csts) {
+      nRecoCsts += csts.size();
+    }
+    const auto index = m_dispatch.Choose(m_recoInput.jets.size(), nRecoCsts);
+    ++m_stats.nIndexEvts[index];
+
+    // size match table and cache reco candidates for event
+    m_table.Init(m_trueInput.csts, m_recoInput.csts);
+    m_recoCache.Build(
+      m_recoInput.jets,
+      m_recoInput.csts,
+      [this](const Types::JetInfo& jet) {return IsGoodJet(jet);},
+      [this](const Types::CstInfo& cst) {return IsGoodCst(cst);},
+      index,
+      m_config.jetMatchDrRange.second
+    );
+    if (m_config.doCstMatchByDr) {
+      m_cstTree.Build(m_recoInput.csts, m_recoCache, m_config.doCstTreePerJet);
+    }
+    if (m_config.doGlobalMatching) {
+      m_assigner.Reset(m_recoCache.GetNJets());
+    }
 
-      // grab evt-level info
-      m_output.evtRec = m_recoInput.evt;
-      m_output.evtGen = m_trueInput.evt;
+    // loop over true jets
+    for (size_t iTrueJet = 0; iTrueJet < m_trueInput.jets.size(); ++iTrueJet) {
+
+      // check if good
+      //   - n.b. if batching, acceptance was already
+      //     checked across the batch (never in chain)
+      const bool            isBatched    = (m_config.batchSize > 1) && !m_isInChain;
+      const Types::JetInfo& genJet       = m_trueInput.jets[iTrueJet];
+      const bool            isGoodGenJet = isBatched ? m_batch.IsTrueGood(m_iBatchEvt, iTrueJet) : IsGoodJet( genJet );
+      if (!isGoodGenJet) continue;
+
+      // start match record
+      //   - n.b. if matching globally, each record is
+      //     a row of the assignment
+      SCorrelatorResponseMakerJetMatch& jetMatch = m_matches.AddJet(iTrueJet);
+      if (m_config.doGlobalMatching) {
+        m_assigner.AddRow();
+      }
 
-      // loop over true jets
-      for (size_t iTrueJet = 0; iTrueJet < m_trueInput.jets.size(); ++iTrueJet) {
+      // add good truth csts to record
+      for (size_t iTrueCst = 0; iTrueCst < m_trueInput.csts[iTrueJet].size(); ++iTrueCst) {
 
         // check if good
-        const auto genJet       = m_trueInput.jets[iTrueJet]; 
-        const bool isGoodGenJet = IsGoodJet( genJet );
-        if (!isGoodGenJet) continue;
+        const Types::CstInfo& genCst        = m_trueInput.csts[iTrueJet][iTrueCst];
+        const bool            isGoodTrueCst = IsGoodCst( genCst );
+        if (!isGoodTrueCst) continue;
 
-        // grab truth jet info
-        m_output.jetGen.push_back( genJet );
-        m_output.cstGen.push_back( {} );
+        m_matches.AddCst(iTrueCst);
 
-        // grab truth cst info
-        const uint64_t nTrueCsts = m_trueInput.csts.at(iTrueJet).size();
-        for (Types::CstInfo& genCst : m_trueInput.csts.at(iTrueJet)) {
+      }  // end true cst loop
 
-          // check if good
-          const bool isGoodTrueCst = IsGoodCst( genCst );
-          if (!isGoodTrueCst) continue;
+      // and collect sorted ids for intersecting
+      const bool isTrueUnique = CollectTrueKeys(jetMatch);
 
-          // add to output
-          m_output.cstGen.back().push_back( genCst );
+      // if using a hash, count overlaps with all reco jets at once
+      if ((index == SCorrelatorResponseMakerRecoCache::Hash) && !m_config.doCstMatchByDr) {
+        m_recoCache.TallyInJets(m_trueIDs, m_jetTally);
+      }
 
-        }  // end true cst loop
+      // if matching csts geometrically over the whole event,
+      // assign truth csts to reco csts once for all candidates
+      if (m_config.doCstMatchByDr && !m_config.doCstTreePerJet) {
+        MatchCstsByDr(iTrueJet, jetMatch, 0);
+        m_jetTally.assign(m_recoCache.GetNJets(), 0);
+        for (const int32_t iPoint : m_candCsts) {
+          if (iPoint >= 0) ++m_jetTally[m_cstTree.points[iPoint].iJet];
+        }
+      }
 
-        // loop over reco jets
-        //   - TODO need bookkeeping container to keep track of matched
-        //     reco jets...
-        bool     wasJetMatched    = false;
-        double   bestFracCstMatch = 0.;
-        uint64_t nMatchCst        = 0;
-        for (size_t iRecoJet = 0; iRecoJet < m_recoInput.jets.size(); ++iRecoJet) {
+      // collect candidate reco jets
+      //   - n.b. if matching one-to-one, reco jets already
+      //     claimed by an earlier truth jet are skipped,
+      //     unless their overlaps are needed for matching
+      //     reco to truth
+      //   - n.b. if batching, the jets passing acceptance
+      //     and the dr/qt windows were already found
+      m_candJets.clear();
+      auto addCandidate = [&](const size_t iRecoJet, const double drJet, const double qtJet) {
+
+        // check if available
+        const bool isClaimed = m_config.isOneToOne && m_table.IsRecoJetMatched(iRecoJet);
+        if (isClaimed && !m_config.doRecoMatching) return;
+
+        // bound fraction of csts it could match
+        //   - n.b. if matching by id and truth ids repeat,
+        //     several truth csts can match the same reco cst
+        const bool     isBounded = isTrueUnique || m_config.doCstMatchByDr;
+        const uint64_t nBound    = isBounded ? min<uint64_t>(jetMatch.nCsts, m_recoCache.GetNCsts(iRecoJet)) : jetMatch.nCsts;
+        const double   bound     = (jetMatch.nCsts > 0) ? ((double) nBound / jetMatch.nCsts) : 0.;
+        m_candJets.push_back( {(int32_t) iRecoJet, bound, drJet, qtJet, isClaimed} );
+
+      };
+      if (isBatched) {
+        const auto cands = m_batch.GetCands(m_iBatchEvt, iTrueJet);
+        for (auto cand = cands.first; cand != cands.second; ++cand) {
+          addCandidate(cand -> iRecoJet, cand -> dr, cand -> qt);
+        }
+      } else {
+        const double genPT  = genJet.GetPT();
+        const double genEta = genJet.GetEta();
+        const double genPhi = genJet.GetPhi();
+        m_recoCache.ForEachNearJet(genEta, genPhi, m_config.jetMatchDrRange.second, [&](const size_t iRecoJet) {
 
           // check if good
-          const auto recJet       = m_recoInput.jets[iRecoJet]; 
-          const bool isGoodRecJet = IsGoodJet( recJet );
-          if (!isGoodRecJet) continue;
-
-          // get matching variables
-          const double drJet = GetDeltaR(recJet, genJet);
-          const double qtJet = recJet.GetPT() / genJet.GetPT();
-
-
-          // loop over true constituents
-          //   - TODO need bookkeeping container to keep track of matched
-          //     reco constituents...
-          for (size_t iTrueCst = 0; iTrueCst < m_output.cstGen.back().size(); ++iTrueCst) {
-
-            // grab true cst info
-            const auto genCst = m_output.cstGen.back()[iTrueCst];
-
-            // loop over reco constituents
-            bool wasCstMatched = false;
-            for (size_t iRecoCst = 0; iRecoCst < m_recoInput.csts[iRecoJet].size(); ++iRecoCst) {
-
-              // check if good
-              const auto recCst       = m_recoInput.csts[iRecoJet][iRecoCst];
-              const bool isGoodRecCst = IsGoodCst( recCst );
-              if (!isGoodRecCst) continue;
-
-              // check ids
-              const bool isMatchedCst = (genCst.GetCstID() == recCst.GetCstID());
-              if (isMatchedCst) {
-
-                // set map, increment counters
-                wasCstMatched      = true;
-                m_cstMap[iTrueCst] = iRecoCst;
-                ++nMatchCst;
-                break;
-
-              }
-            }  // end reco cst loop
-          }  // end true cst loop
-
-          // if jet is best match so far, store values
-          const double fracCstMatch = nMatchCst / nTrueCsts;
-          const bool   isBetterMatch = IsBetterMatch(fracCstMatch, bestFracCstMatch);
-          if (isBetterMatch) {
-            wasJetMatched = true;
+          if (!m_recoCache.isGoodJet[iRecoJet]) return;
+
+          // and if within windows
+          const double drJet = m_recoCache.GetDeltaR(iRecoJet, genEta, genPhi);
+          const double qtJet = m_recoCache.pt[iRecoJet] / genPT;
+          if ((drJet < m_config.jetMatchDrRange.first) || (drJet > m_config.jetMatchDrRange.second)) return;
+          if ((qtJet < m_config.jetMatchQtRange.first) || (qtJet > m_config.jetMatchQtRange.second)) return;
+          addCandidate(iRecoJet, drJet, qtJet);
+
+        });  // end reco jet loop
+      }
+      sort(m_candJets.begin(), m_candJets.end());
+      m_stats.nCandidates += m_candJets.size();
+
+      // loop over candidates
+      //   - n.b. candidates are in order of decreasing bound,
+      //     so the search stops once no remaining candidate
+      //     could beat the best so far (or pass the cut)
+      //   - n.b. ties go to the lowest reco jet index, so the
+      //     result doesn't depend on the search order
+      //   - n.b. if matching reco to truth, every candidate
+      //     is counted to fill the overlap matrix
+      //   - n.b. if matching globally, only candidates that
+      //     can't pass the cut are pruned
+      double bestFracCstMatch = 0.;
+      for (size_t iCand = 0; iCand < m_candJets.size(); ++iCand) {
+
+        const SCorrelatorResponseMakerCandidate& cand = m_candJets[iCand];
+        if (!m_config.doRecoMatching) {
+          const bool isBelowBest = !m_config.doGlobalMatching && (cand.bound < bestFracCstMatch);
+          const bool isBelowCut  = (cand.bound <= m_config.fracCstMatchRange.first);
+          if (isBelowBest || isBelowCut) {
+            m_stats.nPruned += m_candJets.size() - iCand;
+            break;
+          }
+          if (!m_config.doGlobalMatching && (cand.bound == bestFracCstMatch) && (cand.iJet > jetMatch.iRecoJet)) {
+            ++m_stats.nPruned;
+            continue;
           }
-        }  // end reco jet loop
+        }
 
-        // add matched reco jet values to vectors
-        if (wasJetMatched) {
-          /* TODO set matched reco jet values here */
+        // count overlapping constituents
+        //   - n.b. since reco jets can only be claimed as a
+        //     whole, every cst of an available jet is also
+        //     available, so the overlap is the no. of csts
+        //     that will be matched
+        //   - n.b. if matching geometrically, this is the no.
+        //     of truth csts assigned to a reco cst in the jet
+        const size_t iRecoJet  = cand.iJet;
+        size_t       nMatchCst = 0;
+        if (!m_config.doCstMatchByDr && (index == SCorrelatorResponseMakerRecoCache::Hash)) {
+          nMatchCst = m_jetTally[iRecoJet];
+        } else if (!m_config.doCstMatchByDr) {
+          nMatchCst = m_recoCache.CountInJet(iRecoJet, m_trueIDs, isTrueUnique);
+        } else if (m_config.doCstTreePerJet) {
+          nMatchCst = MatchCstsByDr(iTrueJet, jetMatch, iRecoJet);
         } else {
-          /* TODO set placeholder values if not matched */
+          nMatchCst = m_jetTally[iRecoJet];
+        }
+
+        // record overlap, and skip claimed jets
+        if (m_config.doRecoMatching) {
+          m_overlaps.Add(iTrueJet, iRecoJet, nMatchCst);
+        }
+        if (cand.isClaimed) continue;
+        const double fracCstMatch  = (jetMatch.nCsts > 0) ? ((double) nMatchCst / jetMatch.nCsts) : 0.;
+
+        // if matching globally, add pair to assignment
+        //   - n.b. only overlap is weighed by default, with
+        //     dr and qt breaking ties
+        //   - n.b. benefits are shifted so that every pair
+        //     in the windows is positive, as the assigner
+        //     drops the rest
+        if (m_config.doGlobalMatching) {
+          const bool isInWindow = (fracCstMatch > m_config.fracCstMatchRange.first) && (fracCstMatch <= m_config.fracCstMatchRange.second);
+          if (isInWindow) {
+            const double benefit = (m_config.globalFracWeight * fracCstMatch) - (m_config.globalDrWeight * cand.dr) - (m_config.globalQtWeight * abs(1. - cand.qt));
+            m_assigner.AddEdge(
+              iRecoJet,
+              max(benefit + m_assignShift, numeric_limits<double>::min())
+            );
+          }
+          continue;
         }
-      }  // end true jet loop
 
-      // fill output tree
-      FillTree();
+        const bool   isTiedMatch   = jetMatch.IsMatched() && (fracCstMatch == bestFracCstMatch) && (cand.iJet < jetMatch.iRecoJet);
+        const bool   isBetterMatch = IsBetterMatch(fracCstMatch, bestFracCstMatch) || isTiedMatch;
+        if (!isBetterMatch) continue;
 
-    }  // end true event loop
-    PrintMessage(8);
+        // if jet is best match so far, update record
+        bestFracCstMatch      = fracCstMatch;
+        jetMatch.iRecoJet     = iRecoJet;
+        jetMatch.fracCstMatch = fracCstMatch;
+        jetMatch.dr           = cand.dr;
+        jetMatch.qt           = cand.qt;
 
-  }  // end 'DoMatching()'
+        // and match csts in jet
+        FillCstMatches(iRecoJet, jetMatch);
+      }  // end candidate loop
+
+      // record best match in table
+      RecordMatch(jetMatch);
+
+    }  // end true jet loop
+
+    // assign jets if matching globally
+    if (m_config.doGlobalMatching) {
+      AssignJets();
+    }
+
+    // match reco to truth jets
+    if (m_config.doRecoMatching) {
+      MatchRecoJets();
+    }
+    return;
+
+  }  // end 'MatchJets()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Assign truth to reco jets over whole event
+  // --------------------------------------------------------------------------
+  /*! Solves for the one-to-one assignment of truth to
+   *  reco jets with the largest summed benefit over
+   *  the pairs collected in 'MatchJets()', then matches
+   *  the csts of each assigned pair.
+   */
+  void SCorrelatorResponseMaker::AssignJets() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 2)) {
+      PrintDebug(28);
+    }
+
+    // find best assignment
+    m_assigner.Solve();
+
+    // and fill records of assigned truth jets
+    for (size_t iRecord = 0; iRecord < m_matches.jets.size(); ++iRecord) {
+
+      // check if assigned
+      const int32_t iRecoJet = m_assigner.GetCol(iRecord);
+      if (iRecoJet < 0) continue;
+
+      SCorrelatorResponseMakerJetMatch& jetMatch = m_matches.jets[iRecord];
+      const Types::JetInfo&             genJet   = m_trueInput.jets[jetMatch.iTrueJet];
+      const bool                        isUnique = CollectTrueKeys(jetMatch);
+
+      // recount overlap
+      //   - n.b. if matching geometrically over the whole
+      //     event, reco jets assigned to earlier truth jets
+      //     are now excluded, so this can differ from
+      //     the overlap used for the assignment
+      size_t nMatchCst = 0;
+      if (!m_config.doCstMatchByDr) {
+        nMatchCst = m_recoCache.CountInJet(iRecoJet, m_trueIDs, isUnique);
+      } else if (m_config.doCstTreePerJet) {
+        nMatchCst = MatchCstsByDr(jetMatch.iTrueJet, jetMatch, iRecoJet);
+      } else {
+        MatchCstsByDr(jetMatch.iTrueJet, jetMatch, 0);
+        for (const int32_t iPoint : m_candCsts) {
+          if ((iPoint >= 0) && (m_cstTree.points[iPoint].iJet == iRecoJet)) ++nMatchCst;
+        }
+      }
+
+      // drop pair if recounted overlap is no longer in
+      // the allowed window
+      //   - n.b. the record is then left unmatched
+      const double fracCstMatch = (jetMatch.nCsts > 0) ? ((double) nMatchCst / jetMatch.nCsts) : 0.;
+      if (!IsBetterMatch(fracCstMatch, -1.)) continue;
+
+      // update record
+      jetMatch.iRecoJet     = iRecoJet;
+      jetMatch.fracCstMatch = fracCstMatch;
+      jetMatch.dr           = m_recoCache.GetDeltaR(iRecoJet, genJet.GetEta(), genJet.GetPhi());
+      jetMatch.qt           = m_recoCache.pt[iRecoJet] / genJet.GetPT();
+
+      // and match csts
+      FillCstMatches(iRecoJet, jetMatch);
+      RecordMatch(jetMatch);
+
+    }  // end record loop
+    return;
+
+  }  // end 'AssignJets()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match reco to truth jets in current event
+  // --------------------------------------------------------------------------
+  /*! Uses the overlaps found while matching truth jets
+   *  to find the best truth jet of each good reco jet,
+   *  and flags the reco jets and csts left unmatched by
+   *  the truth-to-reco matching as fakes.
+   */
+  void SCorrelatorResponseMaker::MatchRecoJets() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 2)) {
+      PrintDebug(27);
+    }
+
+    // find best truth jet of each reco jet
+    const size_t nRecoJets = m_recoCache.GetNJets();
+    m_overlaps.FindRecoBest(
+      nRecoJets,
+      [this](const int32_t iJet) {return m_recoCache.GetNCsts(iJet);},
+      m_config.fracCstMatchRange
+    );
+
+    // add reco-side records
+    m_recoRecords.assign(nRecoJets, -1);
+    for (size_t iRecoJet = 0; iRecoJet < nRecoJets; ++iRecoJet) {
+
+      // check if good
+      if (!m_recoCache.isGoodJet[iRecoJet]) continue;
+
+      // start record
+      m_recoRecords[iRecoJet] = m_matches.recos.size();
+      SCorrelatorResponseMakerRecoMatch& recoMatch = m_matches.AddReco(iRecoJet);
+      recoMatch.iTrueJet     = m_overlaps.recoBestTrue[iRecoJet];
+      recoMatch.fracCstMatch = m_overlaps.recoBestFrac[iRecoJet];
+      recoMatch.nCsts        = m_recoCache.GetNCsts(iRecoJet);
+      recoMatch.isFake       = !m_table.IsRecoJetMatched(iRecoJet);
+
+      // and collect unmatched csts
+      for (int32_t iGood = m_recoCache.offsets[iRecoJet]; iGood < m_recoCache.offsets[iRecoJet + 1]; ++iGood) {
+        const int32_t iRecoCst = m_recoCache.cstIndices[iGood];
+        if (!m_table.IsRecoCstMatched(iRecoJet, iRecoCst)) {
+          m_matches.AddFake(iRecoCst);
+        }
+      }
+    }  // end reco jet loop
+
+    // link truth records to reco-side records
+    for (SCorrelatorResponseMakerJetMatch& jetMatch : m_matches.jets) {
+      if (jetMatch.IsMatched()) {
+        jetMatch.iRecoRecord = m_recoRecords[jetMatch.iRecoJet];
+      }
+    }
+    return;
+
+  }  // end 'MatchRecoJets()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match truth csts to nearest reco csts
+  // --------------------------------------------------------------------------
+  /*! Truth csts are assigned in order of decreasing pt
+   *  to the nearest reco cst in tree iSeg that's within
+   *  the cst dr/qt windows and not yet assigned, so no
+   *  reco cst is used twice. The index of the assigned
+   *  point (or -1) is left in the candidate array, and
+   *  the no. of assigned csts is returned.
+   */
+  size_t SCorrelatorResponseMaker::MatchCstsByDr(
+    const size_t iTrueJet,
+    const SCorrelatorResponseMakerJetMatch& jetMatch,
+    const size_t iSeg
+  ) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 3)) {
+      PrintDebug(26);
+    }
+
+    // order truth csts by pt
+    const auto& trueCsts = m_trueInput.csts[iTrueJet];
+    m_trueOrder.resize(jetMatch.nCsts);
+    iota(m_trueOrder.begin(), m_trueOrder.end(), 0);
+    sort(
+      m_trueOrder.begin(),
+      m_trueOrder.end(),
+      [&](const int32_t lhs, const int32_t rhs) {
+        const double lhsPT = trueCsts[m_matches.csts[jetMatch.iFirstCst + lhs].iTrueCst].GetPT();
+        const double rhsPT = trueCsts[m_matches.csts[jetMatch.iFirstCst + rhs].iTrueCst].GetPT();
+        return (lhsPT != rhsPT) ? (lhsPT > rhsPT) : (lhs < rhs);
+      }
+    );
+
+    // reco csts of claimed jets aren't available
+    //   - n.b. with a tree per jet, the jet is checked
+    //     by the caller
+    auto isAvailable = [this](const SCorrelatorResponseMakerCstPoint& point) {
+      return m_config.doCstTreePerJet || !(m_config.isOneToOne && m_table.IsRecoJetMatched(point.iJet));
+    };
+
+    // assign each truth cst
+    size_t nMatchCst = 0;
+    m_candCsts.assign(jetMatch.nCsts, -1);
+    for (const int32_t iMatch : m_trueOrder) {
+
+      const Types::CstInfo& genCst = trueCsts[m_matches.csts[jetMatch.iFirstCst + iMatch].iTrueCst];
+      const int32_t         iPoint = m_cstTree.FindNearest(
+        iSeg,
+        genCst.GetEta(),
+        genCst.GetPhi(),
+        genCst.GetPT(),
+        m_config.cstMatchDrRange,
+        m_config.cstMatchQtRange,
+        isAvailable
+      );
+      if (iPoint < 0) continue;
+
+      m_cstTree.Take(iPoint);
+      m_candCsts[iMatch] = iPoint;
+      ++nMatchCst;
+    }
+    m_cstTree.Release();
+    return nMatchCst;
+
+  }  // end 'MatchCstsByDr(size_t, SCorrelatorResponseMakerJetMatch&, size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Collect ids of good truth csts in a record
+  // --------------------------------------------------------------------------
+  /*! Fills the keys (sorted by id, each indexing the
+   *  position of its cst in the record) and the sorted
+   *  ids, and returns whether the ids are unique.
+   */
+  bool SCorrelatorResponseMaker::CollectTrueKeys(const SCorrelatorResponseMakerJetMatch& jetMatch) {
+
+    // collect keys
+    const auto& trueCsts = m_trueInput.csts[jetMatch.iTrueJet];
+    m_trueKeys.clear();
+    for (size_t iMatch = 0; iMatch < jetMatch.nCsts; ++iMatch) {
+      const int32_t iTrueCst = m_matches.csts[jetMatch.iFirstCst + iMatch].iTrueCst;
+      m_trueKeys.push_back( {trueCsts[iTrueCst].GetCstID(), (int32_t) iMatch} );
+    }
+    SCorrelatorResponseMakerCstKey::Sort(m_trueKeys.begin(), m_trueKeys.end());
+
+    // and sorted ids
+    m_trueIDs.clear();
+    for (const SCorrelatorResponseMakerCstKey& key : m_trueKeys) {
+      m_trueIDs.push_back(key.id);
+    }
+    return (adjacent_find(m_trueIDs.begin(), m_trueIDs.end()) == m_trueIDs.end());
+
+  }  // end 'CollectTrueKeys(SCorrelatorResponseMakerJetMatch&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match truth csts of a record to csts of a reco jet
+  // --------------------------------------------------------------------------
+  /*! If matching geometrically, copies the assignments
+   *  left in the candidate array by 'MatchCstsByDr()'.
+   *  Otherwise merge-joins the truth keys with the
+   *  cached reco csts of the jet.
+   */
+  void SCorrelatorResponseMaker::FillCstMatches(const size_t iRecoJet, const SCorrelatorResponseMakerJetMatch& jetMatch) {
+
+    // copy geometric cst matches in jet
+    if (m_config.doCstMatchByDr) {
+      for (size_t iMatch = 0; iMatch < jetMatch.nCsts; ++iMatch) {
+        const int32_t iPoint = m_candCsts[iMatch];
+        const bool    isIn   = (iPoint >= 0) && (m_cstTree.points[iPoint].iJet == (int32_t) iRecoJet);
+        m_matches.csts[jetMatch.iFirstCst + iMatch].iRecoCst = isIn ? m_cstTree.points[iPoint].iCst : -1;
+      }
+      return;
+    }
+
+    // and merge-join true and reco constituents
+    //   - n.b. each truth cst takes the first available
+    //     reco cst with the same id
+    //   - n.b. if reco csts aren't sorted, they're
+    //     scanned from the start for each truth cst
+    //   - n.b. if one-to-one, truth csts with the same
+    //     id (adjacent, as keys are sorted) pick up after
+    //     the reco cst taken by the previous one, since
+    //     the table isn't updated until the jet is recorded
+    const bool   isSorted = m_recoCache.isSorted;
+    const size_t iRecoEnd = m_recoCache.offsets[iRecoJet + 1];
+    size_t       iReco    = m_recoCache.offsets[iRecoJet];
+    int64_t      iTaken   = -1;
+    for (const SCorrelatorResponseMakerCstKey& key : m_trueKeys) {
+
+      // reset previous best
+      SCorrelatorResponseMakerCstMatch& cstMatch = m_matches.csts[jetMatch.iFirstCst + key.index];
+      cstMatch.iRecoCst = -1;
+
+      // advance to first reco cst with same or larger id
+      while (isSorted && (iReco < iRecoEnd) && (m_recoCache.cstIDs[iReco] < key.id)) ++iReco;
+
+      // skip reco csts taken by truth csts with the same id
+      const bool   isRepeat = m_config.isOneToOne && (iTaken >= 0) && (m_recoCache.cstIDs[iTaken] == key.id);
+      const size_t iStart   = isRepeat ? (size_t) iTaken + 1 : iReco;
+
+      // check reco csts with same id
+      for (size_t iSame = iStart; iSame < iRecoEnd; ++iSame) {
+
+        // check id
+        if (m_recoCache.cstIDs[iSame] != key.id) {
+          if (isSorted) break;
+          continue;
+        }
+
+        // check if available
+        const int32_t iRecoCst = m_recoCache.cstIndices[iSame];
+        if (m_config.isOneToOne && m_table.IsRecoCstMatched(iRecoJet, iRecoCst)) continue;
+
+        cstMatch.iRecoCst = iRecoCst;
+        iTaken            = iSame;
+        break;
+
+      }  // end same id loop
+    }  // end true cst loop
+    return;
+
+  }  // end 'FillCstMatches(size_t, SCorrelatorResponseMakerJetMatch&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Record a jet match and its cst matches in table
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::RecordMatch(const SCorrelatorResponseMakerJetMatch& jetMatch) {
+
+    if (!jetMatch.IsMatched()) return;
+
+    m_table.MatchJets(jetMatch.iTrueJet, jetMatch.iRecoJet);
+    for (size_t iMatch = jetMatch.iFirstCst; iMatch < jetMatch.iFirstCst + jetMatch.nCsts; ++iMatch) {
+      const SCorrelatorResponseMakerCstMatch& cst = m_matches.csts[iMatch];
+      if (cst.IsMatched()) {
+        m_table.MatchCsts(jetMatch.iTrueJet, cst.iTrueCst, jetMatch.iRecoJet, cst.iRecoCst);
+      }
+    }
+    return;
+
+  }  // end 'RecordMatch(SCorrelatorResponseMakerJetMatch&)'
 
 
 
@@ -192,7 +783,7 @@ namespace SColdQcdCorrelatorAnalysis {
       PrintDebug(15);
     }
 
-    const bool isMatch  = ((frac > m_config.fracCstMatchRange.first) && (frac < m_config.fracCstMatchRange.second));
+    const bool isMatch  = ((frac > m_config.fracCstMatchRange.first) && (frac <= m_config.fracCstMatchRange.second));
     const bool isBetter = (frac > best);
     return (isMatch && isBetter);
 
@@ -77,23 +77,35 @@ namespace SColdQcdCorrelatorAnalysis {
   // --------------------------------------------------------------------------
   //! Module initialization
   // --------------------------------------------------------------------------
-  void SCorrelatorResponseMaker::Init() {
+  /*! Returns false if the configuration is bad, in
+   *  which case Analyze() and End() do nothing.
+   */
+  bool SCorrelatorResponseMaker::Init() {
 
     // print debug statement
     if (m_config.inDebugMode && (m_config.verbosity > 0)) {
       PrintDebug(2);
     }
 
+    // make sure config can be run with
+    if (!CheckConfig()) return false;
+
     // open files
+    //   - n.b. if resuming from a checkpoint, the
+    //     existing output is reopened instead
     OpenInputFiles();
-    OpenOutputFile();
+    if (!(m_config.doResume && TryResume())) {
+      OpenOutputFile();
+    }
 
     // announce files
     PrintMessage(1);
 
     // initialize input and output
     InitializeTrees();
-    return;
+    InitializeMatching();
+    m_isInit = true;
+    return true;
 
   }  // end 'Init()'
 
@@ -108,6 +120,7 @@ namespace SColdQcdCorrelatorAnalysis {
     if (m_config.inDebugMode && (m_config.verbosity > 0)) {
       PrintDebug(3);
     }
+    if (!m_isInit) return;
 
     // announce start of analysis
     PrintMessage(2);
@@ -129,16 +142,166 @@ namespace SColdQcdCorrelatorAnalysis {
     if (m_config.inDebugMode && (m_config.verbosity > 0)) {
       PrintDebug(4);
     }
+    if (!m_isInit) return;
+
+    // stop allocation tracking
+    if (m_config.doMemTracking) {
+      m_stats.SampleRSS();
+      SCorrelatorResponseMakerMemory::isTracking = false;
+    }
 
     // save output
     SaveOutput();
 
+    // report run statistics
+    if (m_config.doStageTimers || m_config.doMemTracking) {
+      PrintMessage(9);
+    }
+
     // announce end
     PrintMessage(3);
     return;
 
   }  // end 'End()'
 
+
+
+  // f4a methods ==============================================================
+
+  // --------------------------------------------------------------------------
+  //! Run initialization (in-chain mode)
+  // --------------------------------------------------------------------------
+  /*! Opens the output the first time it's called; later
+   *  runs keep writing to the same output.
+   *
+   *  n.b. checkpointing, resuming, and batching don't
+   *  apply here, as the events come from the chain one
+   *  at a time.
+   */
+  int SCorrelatorResponseMaker::InitRun(PHCompositeNode* topNode) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 0)) {
+      PrintDebug(31);
+    }
+
+    if (m_outFile) return Fun4AllReturnCodes::EVENT_OK;
+    if (!CheckConfig()) return Fun4AllReturnCodes::ABORTRUN;
+    m_isInChain = true;
+
+    // announce input nodes
+    PrintMessage(15);
+
+    // initialize output
+    //   - n.b. the total no. of events isn't known up
+    //     front, so it's left as 0
+    OpenOutputFile();
+    InitializeOutputTree();
+    InitializeMatching();
+    m_outRange.first = 0;
+    m_outRange.total = 0;
+    m_isInit         = true;
+
+    // announce start of analysis
+    PrintMessage(2);
+    m_loopStart  = chrono::steady_clock::now();
+    m_loopAllocs = SCorrelatorResponseMakerMemory::nAllocs;
+    return Fun4AllReturnCodes::EVENT_OK;
+
+  }  // end 'InitRun(PHCompositeNode*)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match an event from the node tree (in-chain mode)
+  // --------------------------------------------------------------------------
+  /*! Events are numbered by the order they come in,
+   *  which stands in for the input entry (e.g. in the
+   *  sparse output and jet index).
+   */
+  int SCorrelatorResponseMaker::process_event(PHCompositeNode* topNode) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 2)) {
+      PrintDebug(32);
+    }
+
+    // clear previous event and per-event memory
+    {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::ResetOut, m_config.doStageTimers);
+      m_batch.Reset();
+      ResetBookkeepers();
+      ResetOutVariables();
+    }
+
+    // grab jets and csts from node tree
+    {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::SetInput, m_config.doStageTimers);
+      const bool isTrueFound = m_trueNative.SetNodeAddresses(topNode, m_config.inTrueNodeName);
+      const bool isRecoFound = m_recoNative.SetNodeAddresses(topNode, m_config.inRecoNodeName);
+      if (!isTrueFound || !isRecoFound) {
+        PrintError(16);
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+      const bool isTrueGood = m_trueNative.SetInput(m_trueInput);
+      const bool isRecoGood = m_recoNative.SetInput(m_recoInput);
+      if (!isTrueGood || !isRecoGood) {
+        PrintError(19, m_iChainEvt);
+        return Fun4AllReturnCodes::ABORTRUN;
+      }
+    }
+
+    // n.b. the event is a batch of one, and matching
+    // skips the batch-wide checks in chain mode
+    m_batch.AddEvent(m_iChainEvt, m_trueInput, m_recoInput);
+
+    // match truth to reco jets
+    m_iBatchEvt = 0;
+    m_batch.SwapEvent(m_iBatchEvt, m_trueInput, m_recoInput);
+    {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::Match, m_config.doStageTimers);
+      MatchJets();
+    }
+
+    // fill output tree
+    FillTree();
+    m_batch.SwapEvent(m_iBatchEvt, m_trueInput, m_recoInput);
+    ++m_stats.nEvts;
+
+    // sample memory usage if needed
+    if (m_config.doMemTracking && (m_config.nEvtsPerMemSample > 0) && ((m_iChainEvt % m_config.nEvtsPerMemSample) == 0)) {
+      m_stats.SampleRSS();
+    }
+    ++m_iChainEvt;
+    return Fun4AllReturnCodes::EVENT_OK;
+
+  }  // end 'process_event(PHCompositeNode*)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Module wind-down (in-chain mode)
+  // --------------------------------------------------------------------------
+  int SCorrelatorResponseMaker::End(PHCompositeNode* topNode) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 0)) {
+      PrintDebug(33);
+    }
+
+    // nothing to save if no run was started
+    if (!m_outFile) return Fun4AllReturnCodes::EVENT_OK;
+
+    m_stats.loopTime = chrono::duration<double>(chrono::steady_clock::now() - m_loopStart).count();
+    m_stats.nAllocs  = SCorrelatorResponseMakerMemory::nAllocs - m_loopAllocs;
+    PrintMessage(8);
+
+    // and wind down as usual
+    End();
+    return Fun4AllReturnCodes::EVENT_OK;
+
+  }  // end 'End(PHCompositeNode*)'
+
 }  // end SColdQcdCorrelatorAnalysis namespace
 
 // end ------------------------------------------------------------------------
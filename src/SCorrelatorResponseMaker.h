@@ -14,20 +14,45 @@
 #define SCORRELATORRESPONSEMAKER_H
 
 // c++ utilities
-#include <map>
+#include <memory>
+#include <array>
+#include <deque>
+#include <atomic>
 #include <cmath>
+#include <chrono>
 #include <string>
 #include <vector>
+#include <map>
+#include <cstring>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <random>
+#include <memory_resource>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 #include <cstdlib>
 #include <utility>
+#include <tuple>
+#include <optional>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __SSE2__
+  #include <emmintrin.h>
+#endif
 // root libraries
 #include <TH1.h>
 #include <TROOT.h>
 #include <TFile.h>
+#include <TChain.h>
 #include <TTree.h>
 #include <TMath.h>
+#include <TNamed.h>
 #include <TString.h>
 #include <TDirectory.h>
 #include <Math/Vector3D.h>
@@ -47,9 +72,26 @@
 #include <scorrelatorutilities/Constants.h>
 #include <scorrelatorutilities/Interfaces.h>
 // analysis definitions
+#include "SCorrelatorResponseMakerArena.h"
+#include "SCorrelatorResponseMakerPrecision.h"
+#include "SCorrelatorResponseMakerBins.h"
 #include "SCorrelatorResponseMakerConfig.h"
 #include "SCorrelatorResponseMakerInput.h"
+#include "SCorrelatorResponseMakerBatch.h"
+#include "SCorrelatorResponseMakerMatches.h"
+#include "SCorrelatorResponseMakerTables.h"
+#include "SCorrelatorResponseMakerIntersect.h"
+#include "SCorrelatorResponseMakerCache.h"
+#include "SCorrelatorResponseMakerDispatch.h"
+#include "SCorrelatorResponseMakerAssign.h"
+#include "SCorrelatorResponseMakerKDTree.h"
 #include "SCorrelatorResponseMakerOutput.h"
+#include "SCorrelatorResponseMakerSparseReader.h"
+#include "SCorrelatorResponseMakerShards.h"
+#include "SCorrelatorResponseMakerIndex.h"
+#include "SCorrelatorResponseMakerCheckpoint.h"
+#include "SCorrelatorResponseMakerMemory.h"
+#include "SCorrelatorResponseMakerStats.h"
 
 // make common namespaces
 using namespace std;
@@ -75,20 +117,34 @@ namespace SColdQcdCorrelatorAnalysis {
       ~SCorrelatorResponseMaker() override;
 
       // public methods
-      void Init();
+      bool Init();
       void Analyze();
       void End();
 
+      // f4a methods (in-chain mode)
+      int InitRun(PHCompositeNode* topNode) override;
+      int process_event(PHCompositeNode* topNode) override;
+      int End(PHCompositeNode* topNode) override;
+
       // setters
       void SetConfig(const SCorrelatorResponseMakerConfig& config) {m_config = config;}
 
       // getters
       SCorrelatorResponseMakerConfig GetConfig() {return m_config;}
+      SCorrelatorResponseMakerStats  GetStats()  {return m_stats;}
 
     private:
 
       // analysis methods (*.ana.h)
       void DoMatching();
+      bool ReadEntry(const uint64_t iEntry, const uint64_t iProc, const pair<uint64_t, uint64_t> nProc);
+      void MatchJets();
+      void MatchRecoJets();
+      void AssignJets();
+      size_t MatchCstsByDr(const size_t iTrueJet, const SCorrelatorResponseMakerJetMatch& jetMatch, const size_t iSeg);
+      bool CollectTrueKeys(const SCorrelatorResponseMakerJetMatch& jetMatch);
+      void FillCstMatches(const size_t iRecoJet, const SCorrelatorResponseMakerJetMatch& jetMatch);
+      void RecordMatch(const SCorrelatorResponseMakerJetMatch& jetMatch);
       bool IsBetterMatch(const double frac, const double best);
       bool IsGoodJet(const Types::JetInfo& jet);
       bool IsGoodCst(const Types::CstInfo& cst);
@@ -97,17 +153,35 @@ namespace SColdQcdCorrelatorAnalysis {
       template <typename T> double GetDeltaR(const T& lhs, const T& rhs);
 
       // system methods (*.sys.h)
+      bool CheckConfig();
       void OpenFile(const string& fileName, TFile*& file);
       void OpenInputFiles();
       void OpenOutputFile();
       void InitializeTrees();
+      void InitializeMatching();
+      void InitializeOutputTree();
+      void SetOutputAddresses(TTree* tree);
       void FillTree();  // TODO remove when ready
+      void FillBinTrees();
+      void GetOutput(const SCorrelatorResponseMakerMatches& matches);
+      void IndexJets(const SCorrelatorResponseMakerMatches& matches, const int32_t iBin, const int64_t iOutEntry);
+      void AttachOutputTree();
+      void AttachOutputAddresses(TTree* tree);
+      void RollOverOutput();
+      void CloseOutputChunk();
       void SaveOutput();
+      void WriteCheckpoint(const uint64_t nextEntry);
+      bool TryResume();
+      bool AreBinTreesSaved();
       void ResetOutVariables();  // TODO remove when ready
-      void ResetBookkeepers();
+      void ResetBookkeepers(const bool doInputs = true);
       void PrintMessage(const uint32_t code, const uint64_t iEvt = 0, const pair<uint64_t, uint64_t> nEvts = {0, 0});
       void PrintDebug(const uint32_t code);
       void PrintError(const uint32_t code, const uint64_t iEvt = 0);
+      string GetOutputFileName(const uint32_t iChunk);
+      bool GetEntryRange(const uint64_t nTotal, SCorrelatorResponseMakerRange& range);
+      uint64_t GetConfigHash();
+      string GetCheckpointFileName();
 
       // io members
       TFile* m_outFile    = NULL;
@@ -117,27 +191,87 @@ namespace SColdQcdCorrelatorAnalysis {
       TTree* m_inRecoTree = NULL;
       TTree* m_matchTree  = NULL;
 
+      // in-chain members
+      bool                              m_isInChain  = false;
+      uint64_t                          m_iChainEvt  = 0;
+      uint64_t                          m_loopAllocs = 0;
+      chrono::steady_clock::time_point  m_loopStart;
+
       // system members
-      int m_fTrueCurrent = 0;
-      int m_fRecoCurrent = 0;
+      int      m_fTrueCurrent = 0;
+      int      m_fRecoCurrent = 0;
+      uint32_t m_iOutChunk    = 0;
+      bool     m_isLegacyTrue = true;
+      bool     m_isLegacyReco = true;
+
+      // trees of output bins
+      //   - n.b. the main tree holds the entry of each
+      //     event in each bin tree (-1 if not in it)
+      vector<TTree*>   m_binTrees;
+      vector<int64_t>  m_binEntries;
+      vector<int64_t>* m_binEntriesAddr = &m_binEntries;
+
+      // jet lookup indices of current output chunk
+      SCorrelatorResponseMakerJetIndex m_trueIndex {"ResponseTrueJetIndex"};
+      SCorrelatorResponseMakerJetIndex m_recoIndex {"ResponseRecoJetIndex"};
+
+      // range of entries in current output chunk
+      SCorrelatorResponseMakerRange m_outRange;
+
+      // status members
+      bool m_isInit = false;
+
+      // checkpoint members
+      bool     m_isResumed   = false;
+      uint64_t m_resumeEntry = 0;
 
       // bookkeeping members
-      // FIXME might need TWO indices for cst
-      map<int32_t, int32_t> m_jetMap;
-      map<int32_t, int32_t> m_cstMap;
+      vector<int32_t>                           m_trueIDs;
+      vector<int32_t>                           m_trueOrder;
+      vector<int32_t>                           m_candCsts;
+      vector<uint32_t>                          m_jetTally;
+      vector<int32_t>                           m_recoRecords;
+      vector<SCorrelatorResponseMakerCstKey>    m_trueKeys;
+      vector<SCorrelatorResponseMakerCandidate> m_candJets;
+      SCorrelatorResponseMakerRecoCache         m_recoCache;
+      SCorrelatorResponseMakerDispatcher        m_dispatch;
+      SCorrelatorResponseMakerKDTree            m_cstTree;
+      SCorrelatorResponseMakerMatchTable        m_table;
+      SCorrelatorResponseMakerOverlapMatrix     m_overlaps;
+      SCorrelatorResponseMakerAssigner          m_assigner;
+      double                                    m_assignShift = 0.;
+
+      // match records
+      SCorrelatorResponseMakerMatches m_matches;
+      SCorrelatorResponseMakerMatches m_binMatches;
 
       // configuration
       SCorrelatorResponseMakerConfig m_config; 
 
+      // run statistics
+      SCorrelatorResponseMakerStats m_stats;
+
+      // per-event memory
+      //   - n.b. must be declared before inputs
+      SCorrelatorResponseMakerArena m_arena;
+
       // inputs
-      SCorrelatorResponseMakerRecoInput        m_recoInput;
-      SCorrelatorResponseMakerTruthInput       m_trueInput;
+      SCorrelatorResponseMakerRecoInput        m_recoInput {&m_arena};
+      SCorrelatorResponseMakerTruthInput       m_trueInput {&m_arena};
       SCorrelatorResponseMakerLegacyRecoInput  m_recoLegacy;
       SCorrelatorResponseMakerLegacyTruthInput m_trueLegacy;
+      SCorrelatorResponseMakerNativeRecoInput  m_recoNative;
+      SCorrelatorResponseMakerNativeTruthInput m_trueNative;
+
+      // batch of events being processed
+      //   - n.b. holds inputs, so must be declared after arena
+      SCorrelatorResponseMakerBatch m_batch;
+      size_t                        m_iBatchEvt = 0;
 
       // outputs
       SCorrelatorResponseMakerOutput       m_output;
       SCorrelatorResponseMakerLegacyOutput m_outLegacy;
+      SCorrelatorResponseMakerSparseOutput m_outSparse;
 
   };  // end SCorrelatorResponseMaker
 
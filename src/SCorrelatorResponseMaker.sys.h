@@ -20,6 +20,38 @@ using namespace std;
 
 namespace SColdQcdCorrelatorAnalysis {
 
+  // --------------------------------------------------------------------------
+  //! Check configuration before initializing
+  // --------------------------------------------------------------------------
+  /*! Returns false if any option can't be run with,
+   *  in which case the module shouldn't go any further.
+   */
+  bool SCorrelatorResponseMaker::CheckConfig() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 2)) {
+      PrintDebug(35);
+    }
+
+    bool isGood = true;
+    if (!SCorrelatorResponseMakerRange::IsShard(m_config.iShard, m_config.nShards)) {
+      PrintError(20);
+      isGood = false;
+    }
+    if (!m_config.outBins.IsValid()) {
+      PrintError(21);
+      isGood = false;
+    }
+    if (!SCorrelatorResponseMakerLegacyOutput::CheckPrecisions(m_config.outPrecisions)) {
+      PrintError(22);
+      isGood = false;
+    }
+    return isGood;
+
+  }  // end 'CheckConfig()'
+
+
+
   // --------------------------------------------------------------------------
   //! Open a specified file for reading
   // --------------------------------------------------------------------------
@@ -95,7 +127,7 @@ namespace SColdQcdCorrelatorAnalysis {
     }
 
     // open file
-    m_outFile = new TFile(m_config.outFileName.data(), "recreate");
+    m_outFile = new TFile(GetOutputFileName(m_iOutChunk).data(), "recreate");
     if (!m_outFile) {
       PrintError(11);
       assert(m_outFile);
@@ -106,6 +138,72 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
+  // --------------------------------------------------------------------------
+  //! Get range of input entries to process
+  // --------------------------------------------------------------------------
+  /*! If more than one shard is requested, the input is
+   *  split evenly and the specified shard's range is
+   *  returned. Otherwise, returns nEntries (0 = all)
+   *  starting from firstEntry. Returns false if the
+   *  shard doesn't exist.
+   */
+  bool SCorrelatorResponseMaker::GetEntryRange(const uint64_t nTotal, SCorrelatorResponseMakerRange& range) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(22);
+    }
+
+    // get selected range
+    range.first = min(m_config.firstEntry, nTotal);
+    range.last  = (m_config.nEntries > 0) ? min(range.first + m_config.nEntries, nTotal) : nTotal;
+    range.total = nTotal;
+
+    // and split into shards if needed
+    SCorrelatorResponseMakerRange shard;
+    const bool isShard = SCorrelatorResponseMakerRange::GetShard(
+      range.last - range.first,
+      m_config.iShard,
+      m_config.nShards,
+      shard
+    );
+    if (!isShard) {
+      PrintError(20);
+      return false;
+    }
+    range.last  = range.first + shard.last;
+    range.first = range.first + shard.first;
+    return true;
+
+  }  // end 'GetEntryRange(uint64_t, SCorrelatorResponseMakerRange&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get name of an output file chunk
+  // --------------------------------------------------------------------------
+  /*! If output is rolled over, chunks are numbered by
+   *  inserting an index before the extension, e.g.
+   *  "out.root" -> "out_0000.root", "out_0001.root", ...
+   */
+  string SCorrelatorResponseMaker::GetOutputFileName(const uint32_t iChunk) {
+
+    const bool doRollOver = ((m_config.outMaxFileSize > 0) || (m_config.outMaxEntries > 0));
+    if (!doRollOver) return m_config.outFileName;
+
+    // split name at extension
+    const size_t iDot = m_config.outFileName.rfind(".root");
+    const string stem = m_config.outFileName.substr(0, iDot);
+    const string ext  = (iDot != string::npos) ? m_config.outFileName.substr(iDot) : "";
+
+    stringstream name;
+    name << stem << "_" << setw(4) << setfill('0') << iChunk << ext;
+    return name.str();
+
+  }  // end 'GetOutputFileName(uint32_t)'
+
+
+
   // --------------------------------------------------------------------------
   //! Initialize input/output trees
   // --------------------------------------------------------------------------
@@ -127,24 +225,39 @@ namespace SColdQcdCorrelatorAnalysis {
     }
     m_fRecoCurrent = -1;
     m_fTrueCurrent = -1;
-    m_inRecoTree   -> SetMakeClass(1);
-    m_inTrueTree   -> SetMakeClass(1);
+
+    // determine input formats
+    if (m_config.doDetectInput) {
+      m_isLegacyReco = !SCorrelatorResponseMakerNativeRecoInput::IsNative(m_inRecoTree);
+      m_isLegacyTrue = !SCorrelatorResponseMakerNativeTruthInput::IsNative(m_inTrueTree);
+    } else {
+      m_isLegacyReco = m_config.isLegacyIO;
+      m_isLegacyTrue = m_config.isLegacyIO;
+    }
 
     // set input trees
-    if (m_config.isLegacyIO) {
+    //   - n.b. legacy trees are read as flat branches, while
+    //     native ones are read as objects
+    if (m_isLegacyReco) {
+      m_inRecoTree -> SetMakeClass(1);
       m_recoLegacy.SetTreeAddresses(m_inRecoTree);
+    } else {
+      m_recoNative.SetTreeAddresses(m_inRecoTree, m_config.inMemberStatus);
+    }
+    if (m_isLegacyTrue) {
+      m_inTrueTree -> SetMakeClass(1);
       m_trueLegacy.SetTreeAddresses(m_inTrueTree);
     } else {
-      m_recoInput.SetTreeAddresses(m_inRecoTree);
-      m_trueInput.SetTreeAddresses(m_inTrueTree);
+      m_trueNative.SetTreeAddresses(m_inTrueTree, m_config.inMemberStatus);
     }
 
     // initialize response tree
-    m_matchTree = new TTree("ResponseTree", "A tree of matched truth-reco. events");
-    if (m_config.isLegacyIO) {
-      m_outLegacy.SetTreeAddresses(m_matchTree);
+    //   - n.b. if resuming in a new chunk, there's no
+    //     tree to attach to yet
+    if (m_isResumed && m_matchTree) {
+      AttachOutputTree();
     } else {
-      m_matchTree -> Branch( "Response", &m_output );
+      InitializeOutputTree();
     }
 
     // announce tree setting
@@ -155,6 +268,168 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
+  // --------------------------------------------------------------------------
+  //! Initialize matching
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::InitializeMatching() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(34);
+    }
+
+    // set thresholds for choosing candidate index
+    m_dispatch.maxBruteCsts = m_config.dispatchMaxBruteCsts;
+    m_dispatch.minGridJets  = m_config.dispatchMinGridJets;
+    //   - n.b. if the dr window doesn't split the grid
+    //     into several cells, the benchmark would only
+    //     time a scan against itself
+    const bool isGridUseful = SCorrelatorResponseMakerRecoCache::IsCellSizeUseful(m_config.jetMatchDrRange.second);
+    if (m_config.doCalibrateDispatch && isGridUseful) {
+      m_dispatch.Calibrate(m_config.jetMatchDrRange.second);
+    }
+    PrintMessage(14);
+
+    // get shift making benefits of global matching
+    // positive
+    //   - n.b. this is the most any pair in the windows
+    //     can fall below zero, i.e. with the lowest
+    //     overlap at the edges of the dr and qt windows
+    const double maxQtDev = max(abs(1. - m_config.jetMatchQtRange.first), abs(1. - m_config.jetMatchQtRange.second));
+    m_assignShift = (m_config.globalDrWeight * m_config.jetMatchDrRange.second)
+                  + (m_config.globalQtWeight * maxQtDev)
+                  - (m_config.globalFracWeight * m_config.fracCstMatchRange.first);
+
+    // turn on allocation tracking if needed
+    if (m_config.doMemTracking) {
+      m_stats.trackAllocs = true;
+      m_stats.SampleRSS();
+      SCorrelatorResponseMakerMemory::isTracking = true;
+    }
+    return;
+
+  }  // end 'InitializeMatching()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Initialize output tree in current output file
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::InitializeOutputTree() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(19);
+    }
+
+    m_outFile   -> cd();
+    m_matchTree = new TTree("ResponseTree", "A tree of matched truth-reco. events");
+    m_outLegacy.ResetPacking(m_config.outPrecisions);
+
+    // if binning, output goes to bin trees instead
+    m_binTrees.clear();
+    if (m_config.outBins.GetNBins() > 0) {
+      m_matchTree -> Branch("BinEntries", &m_binEntries);
+      for (size_t iBin = 0; iBin < m_config.outBins.GetNBins(); ++iBin) {
+        m_binTrees.push_back(
+          new TTree(m_config.outBins.GetTreeName(iBin).data(), "A tree of matched truth-reco. jets in a bin")
+        );
+        SetOutputAddresses(m_binTrees.back());
+      }
+    } else {
+      SetOutputAddresses(m_matchTree);
+    }
+
+    // bound memory held by trees
+    m_matchTree -> SetAutoFlush(m_config.outAutoFlush);
+    for (TTree* tree : m_binTrees) {
+      tree -> SetAutoFlush(m_config.outAutoFlush);
+    }
+    if (m_config.outMaxVirtualSize > 0) {
+      m_matchTree -> SetMaxVirtualSize(m_config.outMaxVirtualSize);
+      for (TTree* tree : m_binTrees) {
+        tree -> SetMaxVirtualSize(m_config.outMaxVirtualSize);
+      }
+    }
+    return;
+
+  }  // end 'InitializeOutputTree()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Create output branches on a tree
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::SetOutputAddresses(TTree* tree) {
+
+    if (m_config.doSparseOutput) {
+      m_outSparse.SetTreeAddresses(tree);
+    } else if (m_config.isLegacyIO) {
+      m_outLegacy.SetTreeAddresses(tree, m_config.doRecoMatching);
+    } else {
+      m_output.SetTreeAddresses(tree, m_config.doRecoMatching, m_config.outEvtBasketSize, m_config.outBasketSize);
+    }
+    return;
+
+  }  // end 'SetOutputAddresses(TTree*)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Set addresses on output tree of a resumed run
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::AttachOutputTree() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(23);
+    }
+
+    m_outLegacy.ResetPacking(m_config.outPrecisions);
+    if (m_config.outBins.GetNBins() > 0) {
+      m_matchTree -> SetBranchAddress("BinEntries", &m_binEntriesAddr);
+      for (TTree* tree : m_binTrees) {
+        AttachOutputAddresses(tree);
+      }
+    } else {
+      AttachOutputAddresses(m_matchTree);
+    }
+
+    // bound memory held by trees
+    m_matchTree -> SetAutoFlush(m_config.outAutoFlush);
+    for (TTree* tree : m_binTrees) {
+      tree -> SetAutoFlush(m_config.outAutoFlush);
+    }
+    if (m_config.outMaxVirtualSize > 0) {
+      m_matchTree -> SetMaxVirtualSize(m_config.outMaxVirtualSize);
+      for (TTree* tree : m_binTrees) {
+        tree -> SetMaxVirtualSize(m_config.outMaxVirtualSize);
+      }
+    }
+    return;
+
+  }  // end 'AttachOutputTree()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Set output addresses on an existing tree
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::AttachOutputAddresses(TTree* tree) {
+
+    if (m_config.doSparseOutput) {
+      m_outSparse.AttachTreeAddresses(tree);
+    } else if (m_config.isLegacyIO) {
+      m_outLegacy.AttachTreeAddresses(tree, m_config.doRecoMatching);
+    } else {
+      m_output.AttachTreeAddresses(tree, m_config.doRecoMatching);
+    }
+    return;
+
+  }  // end 'AttachOutputAddresses(TTree*)'
+
+
+
   // --------------------------------------------------------------------------
   //! Fill output tree
   // --------------------------------------------------------------------------
@@ -165,19 +440,211 @@ namespace SColdQcdCorrelatorAnalysis {
       PrintDebug(14);
     }
 
-    // if making legacy output, translate accordingly
-    if (m_config.isLegacyIO) {
-      m_outLegacy.GetOutput(m_output);
+    // materialize output from match records
+    //   - n.b. if binning, output of each bin is filled
+    //     into its tree here, and the main tree only
+    //     records where it went
+    if (m_binTrees.empty()) {
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::GetOutput, m_config.doStageTimers);
+      GetOutput(m_matches);
+      IndexJets(m_matches, -1, m_matchTree -> GetEntries());
+    } else {
+      FillBinTrees();
     }
 
     // fill output tree
+    SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::Fill, m_config.doStageTimers);
     m_matchTree -> Fill();
+
+    // roll over to next file if current one is full
+    const bool isFileFull    = ((m_config.outMaxFileSize > 0) && ((uint64_t) m_outFile -> GetEND() >= m_config.outMaxFileSize));
+    const bool isEntriesFull = ((m_config.outMaxEntries > 0)  && ((uint64_t) m_matchTree -> GetEntries() >= m_config.outMaxEntries));
+    if (isFileFull || isEntriesFull) {
+      RollOverOutput();
+    }
     return;
 
   }  // end 'FillTree()'
 
 
 
+  // --------------------------------------------------------------------------
+  //! Fill output of each bin into its tree
+  // --------------------------------------------------------------------------
+  /*! Truth jet records are binned by the pt (and eta)
+   *  of the truth jet, and fakes by those of the reco
+   *  jet. Bins with no jets or fakes aren't filled.
+   */
+  void SCorrelatorResponseMaker::FillBinTrees() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(30);
+    }
+
+    m_binEntries.assign(m_binTrees.size(), -1);
+    for (size_t iBin = 0; iBin < m_binTrees.size(); ++iBin) {
+
+      // select records in bin
+      {
+        SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::GetOutput, m_config.doStageTimers);
+        m_binMatches.Select(
+          m_matches,
+          [this, iBin](const SCorrelatorResponseMakerJetMatch& jet) {
+            const Types::JetInfo& truth = m_trueInput.jets[jet.iTrueJet];
+            return (m_config.outBins.GetBin(truth.GetPT(), truth.GetEta()) == (int32_t) iBin);
+          },
+          [this, iBin](const SCorrelatorResponseMakerRecoMatch& rec) {
+            const Types::JetInfo& reco = m_recoInput.jets[rec.iRecoJet];
+            return (m_config.outBins.GetBin(reco.GetPT(), reco.GetEta()) == (int32_t) iBin);
+          }
+        );
+        if (m_binMatches.jets.empty() && (m_binMatches.GetNFakeJets() == 0)) continue;
+
+        ResetOutVariables();
+        GetOutput(m_binMatches);
+        IndexJets(m_binMatches, iBin, m_binTrees[iBin] -> GetEntries());
+      }
+
+      // and fill its tree
+      SCorrelatorResponseMakerTimer timer(m_stats, SCorrelatorResponseMakerStats::Fill, m_config.doStageTimers);
+      m_binEntries[iBin] = m_binTrees[iBin] -> GetEntries();
+      m_binTrees[iBin] -> Fill();
+    }
+    return;
+
+  }  // end 'FillBinTrees()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Materialize output from match records
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::GetOutput(const SCorrelatorResponseMakerMatches& matches) {
+
+    if (m_config.doSparseOutput) {
+      const uint64_t iEntry = m_batch.entries[m_iBatchEvt];
+      m_outSparse.GetOutput(matches, iEntry, iEntry);
+    } else if (m_config.isLegacyIO) {
+      m_outLegacy.GetOutput(matches, m_trueInput, m_recoInput, m_config.doRecoMatching);
+      m_outLegacy.Pack();
+    } else {
+      m_output.GetOutput(matches, m_trueInput, m_recoInput, m_config.doRecoMatching);
+    }
+    return;
+
+  }  // end 'GetOutput(SCorrelatorResponseMakerMatches&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Record where jets of current event go in output
+  // --------------------------------------------------------------------------
+  /*! Truth jets are keyed by their jet ID, and so are
+   *  the reco jets they're matched to. Fakes aren't
+   *  indexed. If matching isn't one-to-one, a reco jet
+   *  gets a row for each truth jet it's matched to.
+   */
+  void SCorrelatorResponseMaker::IndexJets(
+    const SCorrelatorResponseMakerMatches& matches,
+    const int32_t iBin,
+    const int64_t iOutEntry
+  ) {
+
+    if (!m_config.doJetIndex) return;
+
+    const uint64_t iEntry = m_batch.entries[m_iBatchEvt];
+    for (size_t iJet = 0; iJet < matches.jets.size(); ++iJet) {
+      const SCorrelatorResponseMakerJetMatch& jet = matches.jets[iJet];
+      m_trueIndex.Add(iEntry, m_trueInput.jets[jet.iTrueJet].GetJetID(), iBin, iOutEntry, iJet);
+      if (jet.IsMatched()) {
+        m_recoIndex.Add(iEntry, m_recoInput.jets[jet.iRecoJet].GetJetID(), iBin, iOutEntry, iJet);
+      }
+    }
+    return;
+
+  }  // end 'IndexJets(SCorrelatorResponseMakerMatches&, int32_t, int64_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Close current output chunk and open the next one
+  // --------------------------------------------------------------------------
+  void SCorrelatorResponseMaker::RollOverOutput() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(20);
+    }
+
+    CloseOutputChunk();
+    ++m_iOutChunk;
+    OpenOutputFile();
+    InitializeOutputTree();
+
+    // announce roll over
+    PrintMessage(10);
+    return;
+
+  }  // end 'RollOverOutput()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write, close, and sync current output file
+  // --------------------------------------------------------------------------
+  /*! Once this returns, the chunk is complete on disk
+   *  and can be picked up by downstream jobs.
+   */
+  void SCorrelatorResponseMaker::CloseOutputChunk() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(21);
+    }
+
+    // record range of entries in chunk
+    m_outRange.last = m_outRange.first + m_matchTree -> GetEntries();
+    m_outRange.Write(m_outFile);
+
+    // write and close file
+    //   - n.b. closing the file deletes the trees
+    const string fileName = m_outFile -> GetName();
+    m_outFile -> cd();
+    m_matchTree -> Write();
+    if (!m_binTrees.empty()) {
+      for (TTree* tree : m_binTrees) {
+        tree -> Write();
+      }
+      m_config.outBins.WriteIndex(m_outFile, m_binTrees);
+    }
+    if (m_config.doJetIndex) {
+      m_trueIndex.Write(m_outFile);
+      m_recoIndex.Write(m_outFile);
+      m_trueIndex.Reset();
+      m_recoIndex.Reset();
+    }
+    m_outFile -> Close();
+    delete m_outFile;
+    m_outFile   = NULL;
+    m_matchTree = NULL;
+    m_binTrees.clear();
+
+    // flush to disk
+    const int fd = ::open(fileName.data(), O_RDONLY);
+    if (fd >= 0) {
+      ::fsync(fd);
+      ::close(fd);
+    }
+
+    // next chunk starts where this one left off
+    m_outRange.first = m_outRange.last;
+    return;
+
+  }  // end 'CloseOutputChunk()'
+
+
+
   // --------------------------------------------------------------------------
   //! Save output
   // --------------------------------------------------------------------------
@@ -188,8 +655,20 @@ namespace SColdQcdCorrelatorAnalysis {
       PrintDebug(9);
     }
 
-    m_outFile   -> cd();
-    m_matchTree -> Write();
+    // save run statistics if needed
+    if (m_config.saveStats) {
+      m_stats.Write(m_outFile);
+    }
+
+    // write tree and close last chunk
+    CloseOutputChunk();
+
+    // run is complete, so checkpoint is no longer needed
+    //   - n.b. no checkpoint is written in chain, so any
+    //     existing one belongs to another run
+    if ((m_config.nEvtsPerCheckpoint > 0) && !m_isInChain) {
+      remove(GetCheckpointFileName().data());
+    }
 
     // announce saving
     PrintMessage(4);
@@ -199,6 +678,270 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
+  // --------------------------------------------------------------------------
+  //! Save output and record progress
+  // --------------------------------------------------------------------------
+  /*! The tree header is saved to the output file first
+   *  (without closing it) so that the file on disk holds
+   *  every entry up to nextEntry, and then the checkpoint
+   *  is written.
+   */
+  void SCorrelatorResponseMaker::WriteCheckpoint(const uint64_t nextEntry) {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(24);
+    }
+
+    // save trees and sync to disk
+    m_matchTree -> AutoSave("SaveSelf");
+    for (TTree* tree : m_binTrees) {
+      tree -> AutoSave("SaveSelf");
+    }
+    if (m_config.doJetIndex) {
+      m_trueIndex.Stage(m_outFile);
+      m_recoIndex.Stage(m_outFile);
+    }
+    const int fd = ::open(m_outFile -> GetName(), O_RDONLY);
+    if (fd >= 0) {
+      ::fsync(fd);
+      ::close(fd);
+    }
+
+    // record progress
+    SCorrelatorResponseMakerCheckpoint checkpoint;
+    checkpoint.configHash  = GetConfigHash();
+    checkpoint.trueInputID = SCorrelatorResponseMakerCheckpoint::GetFileID(m_inTrueFile);
+    checkpoint.recoInputID = SCorrelatorResponseMakerCheckpoint::GetFileID(m_inRecoFile);
+    checkpoint.iChunk      = m_iOutChunk;
+    checkpoint.chunkFirst  = m_outRange.first;
+    checkpoint.nextEntry   = nextEntry;
+    if (!checkpoint.Write(GetCheckpointFileName())) {
+      PrintError(12);
+    }
+    return;
+
+  }  // end 'WriteCheckpoint(uint64_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Try to resume from a checkpoint
+  // --------------------------------------------------------------------------
+  /*! If a checkpoint from the same configuration and
+   *  inputs exists, reopens its output chunk (or opens
+   *  the next one if it was closed) and sets the entry
+   *  to resume from. Otherwise returns false and the
+   *  run starts from scratch.
+   */
+  bool SCorrelatorResponseMaker::TryResume() {
+
+    // print debug statement
+    if (m_config.inDebugMode && (m_config.verbosity > 1)) {
+      PrintDebug(25);
+    }
+
+    // check if there is a checkpoint to resume from
+    SCorrelatorResponseMakerCheckpoint checkpoint;
+    if (!checkpoint.Read(GetCheckpointFileName())) {
+      PrintMessage(12);
+      return false;
+    }
+
+    // check if it's from the same run
+    SCorrelatorResponseMakerCheckpoint current;
+    current.configHash  = GetConfigHash();
+    current.trueInputID = SCorrelatorResponseMakerCheckpoint::GetFileID(m_inTrueFile);
+    current.recoInputID = SCorrelatorResponseMakerCheckpoint::GetFileID(m_inRecoFile);
+    if (!checkpoint.IsSameRun(current)) {
+      PrintError(13);
+      return false;
+    }
+
+    // reopen output chunk
+    m_iOutChunk = checkpoint.iChunk;
+    m_outFile   = new TFile(GetOutputFileName(m_iOutChunk).data(), "update");
+    if (!m_outFile || m_outFile -> IsZombie()) {
+      PrintError(14);
+      delete m_outFile;
+      m_outFile   = NULL;
+      m_iOutChunk = 0;
+      return false;
+    }
+
+    // if chunk was already closed (i.e. its range was
+    // written), resume in a new chunk after it
+    //   - n.b. this can only happen if the run stopped
+    //     between closing a chunk and checkpointing
+    //     the next one
+    SCorrelatorResponseMakerRange closed;
+    if (closed.Read(m_outFile)) {
+      m_outFile -> Close();
+      delete m_outFile;
+      ++m_iOutChunk;
+      OpenOutputFile();
+      m_outRange.first = closed.last;
+      m_resumeEntry    = closed.last;
+      m_isResumed      = true;
+      PrintMessage(13);
+      return true;
+    }
+
+    m_outFile -> GetObject("ResponseTree", m_matchTree);
+    m_binTrees.assign(m_config.outBins.GetNBins(), NULL);
+    for (size_t iBin = 0; iBin < m_binTrees.size(); ++iBin) {
+      m_outFile -> GetObject(m_config.outBins.GetTreeName(iBin).data(), m_binTrees[iBin]);
+    }
+    const bool isBinMissing = any_of(
+      m_binTrees.begin(),
+      m_binTrees.end(),
+      [](TTree* tree) {return (tree == NULL);}
+    );
+    if (!m_matchTree || isBinMissing) {
+      PrintError(14);
+      m_outFile -> Close();
+      delete m_outFile;
+      m_outFile   = NULL;
+      m_iOutChunk = 0;
+      m_matchTree = NULL;
+      m_binTrees.clear();
+      return false;
+    }
+
+    // make sure saved output agrees with checkpoint
+    //   - n.b. the tree (and staged jet indices) can be
+    //     ahead of the checkpoint if the job stopped
+    //     while checkpointing; entries can't be removed
+    //     from them, so start from scratch then
+    const uint64_t nSaved    = checkpoint.chunkFirst + m_matchTree -> GetEntries();
+    const bool     isTreeOK  = (nSaved == checkpoint.nextEntry) && AreBinTreesSaved();
+    const bool     isIndexOK = !m_config.doJetIndex || (
+      m_trueIndex.Read(m_outFile, checkpoint.nextEntry) &&
+      m_recoIndex.Read(m_outFile, checkpoint.nextEntry)
+    );
+    if (!isTreeOK || !isIndexOK) {
+      PrintError(15);
+      m_trueIndex.Reset();
+      m_recoIndex.Reset();
+      m_outFile -> Close();
+      delete m_outFile;
+      m_outFile   = NULL;
+      m_iOutChunk = 0;
+      m_matchTree = NULL;
+      m_binTrees.clear();
+      return false;
+    }
+
+    // resume from checkpoint
+    //   - n.b. staged jet index rows were picked up
+    //     above
+    m_outRange.first = checkpoint.chunkFirst;
+    m_resumeEntry    = checkpoint.nextEntry;
+    m_isResumed      = true;
+
+    // announce resuming
+    PrintMessage(13);
+    return true;
+
+  }  // end 'TryResume()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check bin trees of a resumed run against main tree
+  // --------------------------------------------------------------------------
+  /*! Each bin tree must have exactly the entries the
+   *  BinEntries of the main tree point to, as they're
+   *  saved separately and one can get ahead of another
+   *  if the job stops while checkpointing.
+   */
+  bool SCorrelatorResponseMaker::AreBinTreesSaved() {
+
+    if (m_binTrees.empty()) return true;
+
+    const vector<int64_t> nExpect = SCorrelatorResponseMakerBinning::GetNExpected(m_matchTree, m_binTrees.size());
+    for (size_t iBin = 0; iBin < m_binTrees.size(); ++iBin) {
+      if (m_binTrees[iBin] -> GetEntries() != nExpect[iBin]) return false;
+    }
+    return true;
+
+  }  // end 'AreBinTreesSaved()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get hash of configuration
+  // --------------------------------------------------------------------------
+  /*! Only options which change what's written to the
+   *  output are included.
+   */
+  uint64_t SCorrelatorResponseMaker::GetConfigHash() {
+
+    stringstream cfg;
+    cfg << m_config.inTrueFileName << ";"
+        << m_config.inRecoFileName << ";"
+        << m_config.inTrueTreeName << ";"
+        << m_config.inRecoTreeName << ";"
+        << m_config.outFileName << ";"
+        << m_config.isLegacyIO << ";"
+        << m_config.doSparseOutput << ";"
+        << m_config.doJetIndex << ";"
+        << m_config.doDetectInput << ";"
+        << m_config.useStoredCstEne << ";"
+        << m_config.isOneToOne << ";"
+        << m_config.doCstMatchByDr << ";"
+        << m_config.doCstTreePerJet << ";"
+        << m_config.doRecoMatching << ";"
+        << m_config.doGlobalMatching << ";"
+        << m_config.globalFracWeight << "," << m_config.globalDrWeight << "," << m_config.globalQtWeight << ";"
+        << m_config.firstEntry << ";"
+        << m_config.nEntries << ";"
+        << m_config.iShard << ";"
+        << m_config.nShards << ";"
+        << m_config.outMaxFileSize << ";"
+        << m_config.outMaxEntries << ";"
+        << m_config.fracCstMatchRange.first << "," << m_config.fracCstMatchRange.second << ";"
+        << m_config.jetMatchQtRange.first   << "," << m_config.jetMatchQtRange.second   << ";"
+        << m_config.cstMatchQtRange.first   << "," << m_config.cstMatchQtRange.second   << ";"
+        << m_config.jetMatchDrRange.first   << "," << m_config.jetMatchDrRange.second   << ";"
+        << m_config.cstMatchDrRange.first   << "," << m_config.cstMatchDrRange.second   << ";";
+    for (const auto& [pattern, status] : m_config.inMemberStatus) {
+      cfg << pattern << "," << status << ";";
+    }
+    for (const double edge : m_config.outBins.ptEdges) {
+      cfg << edge << ",";
+    }
+    cfg << ";";
+    for (const double edge : m_config.outBins.etaEdges) {
+      cfg << edge << ",";
+    }
+    cfg << ";";
+    for (const auto& [field, precision] : m_config.outPrecisions) {
+      cfg << field << "," << precision.mode << "," << precision.nBits << ";";
+    }
+    for (const Types::JetInfo& jet : {m_config.jetAccept.first, m_config.jetAccept.second}) {
+      cfg << jet.GetPT() << "," << jet.GetEta() << "," << jet.GetPhi() << "," << jet.GetEne() << ";";
+    }
+    for (const Types::CstInfo& cst : {m_config.cstAccept.first, m_config.cstAccept.second}) {
+      cfg << cst.GetPT() << "," << cst.GetEta() << "," << cst.GetPhi() << "," << cst.GetEne() << "," << cst.GetZ() << "," << cst.GetDR() << ";";
+    }
+    return SCorrelatorResponseMakerCheckpoint::Hash(cfg.str());
+
+  }  // end 'GetConfigHash()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get name of checkpoint file
+  // --------------------------------------------------------------------------
+  string SCorrelatorResponseMaker::GetCheckpointFileName() {
+
+    return m_config.checkpointFileName.empty() ? (m_config.outFileName + ".ckpt") : m_config.checkpointFileName;
+
+  }  // end 'GetCheckpointFileName()'
+
+
+
   // --------------------------------------------------------------------------
   //! Reset output variables
   // --------------------------------------------------------------------------
@@ -211,6 +954,7 @@ namespace SColdQcdCorrelatorAnalysis {
 
     m_output.Reset();
     m_outLegacy.Reset();
+    m_outSparse.Reset();
     return;
 
   }  // end 'ResetOutVariables()'
@@ -220,17 +964,31 @@ namespace SColdQcdCorrelatorAnalysis {
   // --------------------------------------------------------------------------
   //! Reset bookkeeping variables
   // --------------------------------------------------------------------------
-  void SCorrelatorResponseMaker::ResetBookkeepers() {
+  /*! If doInputs is false, the inputs and the arena
+   *  are left alone (e.g. between events of a batch).
+   */
+  void SCorrelatorResponseMaker::ResetBookkeepers(const bool doInputs) {
 
     // print debug statement
     if (m_config.inDebugMode && (m_config.verbosity > 2)) {
       PrintDebug(17);
     }
 
-    m_cstMap.clear();
+    // empty inputs before reclaiming their memory
+    if (doInputs) {
+      m_recoInput.Reset();
+      m_trueInput.Reset();
+      m_arena.Reset();
+    }
+
+    m_table.Reset();
+    m_recoCache.Reset();
+    m_cstTree.Reset();
+    m_overlaps.Reset();
+    m_matches.Reset();
     return;
 
-  }  // end 'ResetBookkeepers()'
+  }  // end 'ResetBookkeepers(bool)'
 
 
 
@@ -270,7 +1028,8 @@ namespace SColdQcdCorrelatorAnalysis {
       case 5:
         cout << "    Initialized input trees:\n"
              << "      input truth tree = " << m_config.inTrueTreeName << "\n"
-             << "      input reco tree  = " << m_config.inRecoTreeName
+             << "      input reco tree  = " << m_config.inRecoTreeName << "\n"
+             << "      input formats    = " << (m_isLegacyTrue ? "legacy" : "native") << " (truth), " << (m_isLegacyReco ? "legacy" : "native") << " (reco)"
              << endl;
         break;
       case 6:
@@ -286,6 +1045,41 @@ namespace SColdQcdCorrelatorAnalysis {
       case 8:
         cout << "    Finished event loop." << endl;
         break;
+      case 9:
+        m_stats.Print();
+        break;
+      case 10:
+        cout << "\n      Rolled over output: now writing to " << m_outFile -> GetName() << endl;
+        break;
+      case 11:
+        cout << "      Processing entries [" << m_outRange.first << ", " << m_outRange.last << ") of " << m_outRange.total << "." << endl;
+        break;
+      case 12:
+        cout << "    No checkpoint found: starting from scratch." << endl;
+        break;
+      case 13:
+        cout << "    Resuming from checkpoint:\n"
+             << "      output file = " << m_outFile -> GetName() << "\n"
+             << "      next entry  = " << m_resumeEntry
+             << endl;
+        break;
+      case 14:
+        cout << "    Candidate index thresholds" << (m_dispatch.isCalibrated ? " (calibrated)" : "") << ":\n"
+             << "      scan if <= " << m_dispatch.maxBruteCsts << " csts per jet, else hash\n"
+             << "      bin in eta-phi if >= ";
+        if (m_dispatch.minGridJets == numeric_limits<uint64_t>::max()) {
+          cout << "(never)";
+        } else {
+          cout << m_dispatch.minGridJets;
+        }
+        cout << " jets" << endl;
+        break;
+      case 15:
+        cout << "    Initializing response maker in chain:\n"
+             << "      input truth node = " << m_config.inTrueNodeName << "\n"
+             << "      input reco node  = " << m_config.inRecoNodeName
+             << endl;
+        break;
       default:
         PrintError(code);
         break;
@@ -359,7 +1153,61 @@ namespace SColdQcdCorrelatorAnalysis {
         cout << "SCorrelatorResponseMaker::ResetOutVariables() resetting output variables..." << endl;
         break;
       case 17:
-        cout << "SCorrelatorResponseMaker::ResetBookkeepers() resetting bookkeeping variables..." << endl;
+        cout << "SCorrelatorResponseMaker::ResetBookkeepers(bool) resetting bookkeeping variables..." << endl;
+        break;
+      case 18:
+        cout << "SCorrelatorResponseMaker::MatchJets() matching jets in event..." << endl;
+        break;
+      case 19:
+        cout << "SCorrelatorResponseMaker::InitializeOutputTree() initializing output tree..." << endl;
+        break;
+      case 20:
+        cout << "SCorrelatorResponseMaker::RollOverOutput() rolling over output file..." << endl;
+        break;
+      case 21:
+        cout << "SCorrelatorResponseMaker::CloseOutputChunk() closing output file..." << endl;
+        break;
+      case 22:
+        cout << "SCorrelatorResponseMaker::GetEntryRange(uint64_t, SCorrelatorResponseMakerRange&) getting range of entries to process..." << endl;
+        break;
+      case 23:
+        cout << "SCorrelatorResponseMaker::AttachOutputTree() attaching to existing output tree..." << endl;
+        break;
+      case 24:
+        cout << "SCorrelatorResponseMaker::WriteCheckpoint(uint64_t) writing checkpoint..." << endl;
+        break;
+      case 25:
+        cout << "SCorrelatorResponseMaker::TryResume() trying to resume from checkpoint..." << endl;
+        break;
+      case 26:
+        cout << "SCorrelatorResponseMaker::MatchCstsByDr(size_t, SCorrelatorResponseMakerJetMatch&, size_t) matching csts by dr..." << endl;
+        break;
+      case 27:
+        cout << "SCorrelatorResponseMaker::MatchRecoJets() matching reco to truth jets..." << endl;
+        break;
+      case 28:
+        cout << "SCorrelatorResponseMaker::AssignJets() assigning truth to reco jets..." << endl;
+        break;
+      case 29:
+        cout << "SCorrelatorResponseMaker::ReadEntry(uint64_t, uint64_t, pair<uint64_t, uint64_t>) reading entry..." << endl;
+        break;
+      case 30:
+        cout << "SCorrelatorResponseMaker::FillBinTrees() filling bin trees..." << endl;
+        break;
+      case 31:
+        cout << "SCorrelatorResponseMaker::InitRun(PHCompositeNode*) initializing run in chain..." << endl;
+        break;
+      case 32:
+        cout << "SCorrelatorResponseMaker::process_event(PHCompositeNode*) processing event from node tree..." << endl;
+        break;
+      case 33:
+        cout << "SCorrelatorResponseMaker::End(PHCompositeNode*) winding down in chain..." << endl;
+        break;
+      case 34:
+        cout << "SCorrelatorResponseMaker::InitializeMatching() initializing matching..." << endl;
+        break;
+      case 35:
+        cout << "SCorrelatorResponseMaker::CheckConfig() checking configuration..." << endl;
         break;
       default:
         PrintError(code);
@@ -397,6 +1245,39 @@ namespace SColdQcdCorrelatorAnalysis {
       case 5:
         cerr << "WARNING: issue with entry " << iEvt << " in reco tree! Aborting event loop!" << endl;
         break;
+      case 12:
+        cerr << "WARNING: couldn't write checkpoint!" << endl;
+        break;
+      case 13:
+        cerr << "WARNING: checkpoint is from a different configuration or input! Starting from scratch." << endl;
+        break;
+      case 14:
+        cerr << "WARNING: couldn't reopen output of checkpoint! Starting from scratch." << endl;
+        break;
+      case 15:
+        cerr << "WARNING: saved output doesn't match checkpoint! Starting from scratch." << endl;
+        break;
+      case 16:
+        cerr << "PANIC: couldn't find input jets on node tree! Aborting run!" << endl;
+        break;
+      case 17:
+        cerr << "WARNING: entry " << iEvt << " in truth tree is malformed! Aborting event loop!" << endl;
+        break;
+      case 18:
+        cerr << "WARNING: entry " << iEvt << " in reco tree is malformed! Aborting event loop!" << endl;
+        break;
+      case 19:
+        cerr << "PANIC: input jets of event " << iEvt << " on node tree are malformed! Aborting run!" << endl;
+        break;
+      case 20:
+        cerr << "PANIC: shard " << m_config.iShard << " of " << m_config.nShards << " doesn't exist! Aborting!" << endl;
+        break;
+      case 21:
+        cerr << "PANIC: output bin edges aren't strictly increasing! Aborting!" << endl;
+        break;
+      case 22:
+        cerr << "PANIC: bad output precisions! Aborting!" << endl;
+        break;
       default:
         cerr << "WARNING: unknown status code!\n"
              << "         code = " << code
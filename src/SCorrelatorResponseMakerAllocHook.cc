@@ -0,0 +1,96 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerAllocHook.cc
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Replacement global allocation functions which
+ *  feed the 'SCorrelatorResponseMakerMemory'
+ *  counters. Only compiled when configured with
+ *  '--enable-alloc-hook'.
+ *
+ *  n.b. ROOT resolves operator new before loading
+ *  module libraries, so when running from a macro
+ *  the library needs to be preloaded for the hook
+ *  to take effect, e.g.
+ *
+ *    LD_PRELOAD=libscorrelatorresponsemaker.so root -b -q ...
+ */
+/// ---------------------------------------------------------------------------
+
+#define SCORRELATORRESPONSEMAKERALLOCHOOK_CC
+
+// c++ utilities
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+// module definitions
+#include "SCorrelatorResponseMakerMemory.h"
+
+using namespace std;
+using namespace SColdQcdCorrelatorAnalysis;
+
+
+
+// flag hook as active ========================================================
+
+namespace {
+
+  // --------------------------------------------------------------------------
+  //! Mark hook as compiled in on library load
+  // --------------------------------------------------------------------------
+  const bool isHookSet = []() {
+    SCorrelatorResponseMakerMemory::isHooked = true;
+    return true;
+  }();
+
+}  // end anonymous namespace
+
+
+
+// replacement allocation functions ===========================================
+
+void* operator new(size_t size) {
+
+  SCorrelatorResponseMakerMemory::Count(size);
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (!ptr) throw bad_alloc();
+  return ptr;
+
+}  // end 'operator new(size_t)'
+
+
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+
+  SCorrelatorResponseMakerMemory::Count(size);
+  return malloc(size == 0 ? 1 : size);
+
+}  // end 'operator new(size_t, nothrow_t&)'
+
+
+
+void operator delete(void* ptr) noexcept {
+
+  free(ptr);
+
+}  // end 'operator delete(void*)'
+
+
+
+void operator delete(void* ptr, size_t) noexcept {
+
+  free(ptr);
+
+}  // end 'operator delete(void*, size_t)'
+
+
+
+void operator delete(void* ptr, const nothrow_t&) noexcept {
+
+  free(ptr);
+
+}  // end 'operator delete(void*, nothrow_t&)'
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,209 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerArena.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Per-event memory management for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERARENA_H
+#define SCORRELATORRESPONSEMAKERARENA_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Monotonic per-event arena
+  // --------------------------------------------------------------------------
+  /*! A bump allocator for containers which only live
+   *  for a single event. Deallocation is a no-op and all
+   *  memory is reclaimed at once by Reset(). If an event
+   *  overflows the arena, extra chunks are allocated and
+   *  then coalesced into a single chunk on the next
+   *  Reset(), so once the arena has grown to the largest
+   *  event no further allocations are made.
+   *
+   *  n.b. any containers using the arena must be emptied
+   *  before calling Reset().
+   */
+  class SCorrelatorResponseMakerArena : public pmr::memory_resource {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting initial size in bytes
+      // ----------------------------------------------------------------------
+      SCorrelatorResponseMakerArena(const size_t size = 1 << 16) {
+
+        AddChunk(size);
+
+      }  // end ctor(size_t)
+
+      // ----------------------------------------------------------------------
+      //! Reclaim all memory
+      // ----------------------------------------------------------------------
+      void Reset() {
+
+        // if overflowed, replace chunks with one big enough to
+        // hold everything
+        if (m_chunks.size() > 1) {
+          size_t total = 0;
+          for (const Chunk& chunk : m_chunks) {
+            total += chunk.size;
+          }
+          m_chunks.clear();
+          AddChunk(total);
+        }
+        m_chunks.back().used = 0;
+        return;
+
+      }  // end 'Reset()'
+
+      // getters
+      size_t GetCapacity() const {return m_chunks.front().size;}
+      size_t GetNChunks()  const {return m_chunks.size();}
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! A contiguous block of memory
+      // ----------------------------------------------------------------------
+      struct Chunk {
+        unique_ptr<byte[]> data;
+        size_t             size = 0;
+        size_t             used = 0;
+      };
+
+      // ----------------------------------------------------------------------
+      //! Add a new chunk to the arena
+      // ----------------------------------------------------------------------
+      void AddChunk(const size_t size) {
+
+        Chunk chunk;
+        chunk.data.reset(new byte[size]);
+        chunk.size = size;
+        m_chunks.push_back(move(chunk));
+        return;
+
+      }  // end 'AddChunk(size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Allocate from current chunk, adding a chunk if needed
+      // ----------------------------------------------------------------------
+      void* do_allocate(size_t bytes, size_t alignment) override {
+
+        // try to fit in current chunk
+        Chunk& chunk = m_chunks.back();
+        void*  ptr   = chunk.data.get() + chunk.used;
+        size_t space = chunk.size - chunk.used;
+        if (align(alignment, bytes, ptr, space)) {
+          chunk.used = (static_cast<byte*>(ptr) - chunk.data.get()) + bytes;
+          return ptr;
+        }
+
+        // otherwise grow geometrically
+        AddChunk(max(2 * chunk.size, bytes + alignment));
+        return do_allocate(bytes, alignment);
+
+      }  // end 'do_allocate(size_t, size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Deallocation is a no-op: memory is reclaimed by Reset()
+      // ----------------------------------------------------------------------
+      void do_deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) override {
+        return;
+      }
+
+      // ----------------------------------------------------------------------
+      //! Arenas are only equal to themselves
+      // ----------------------------------------------------------------------
+      bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return (this == &other);
+      }
+
+      // memory chunks
+      vector<Chunk> m_chunks;
+
+  };  // end SCorrelatorResponseMakerArena
+
+
+
+  // --------------------------------------------------------------------------
+  //! Recycler for nested output vectors
+  // --------------------------------------------------------------------------
+  /*! Output containers are streamed by ROOT and so can't
+   *  use the arena. Instead, rather than destroying the
+   *  inner vectors of a nested vector on reset, they're
+   *  kept (with their capacity) in a pool of spares and
+   *  handed back out as the nested vector grows again.
+   *  Each recycler owns its pool, so it should live as
+   *  long as (and alongside) the vectors it serves.
+   */
+  template <typename T> struct SCorrelatorResponseMakerRecycler {
+
+    // pool of spare inner vectors
+    vector<vector<T>> spares;
+
+    // ------------------------------------------------------------------------
+    //! Empty a nested vector, moving inner vectors to pool
+    // ------------------------------------------------------------------------
+    void Recycle(vector<vector<T>>& nested) {
+
+      for (vector<T>& inner : nested) {
+        inner.clear();
+        spares.push_back( move(inner) );
+      }
+      nested.clear();
+      return;
+
+    }  // end 'Recycle(vector<vector<T>>&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Add an empty inner vector, taking it from pool if possible
+    // ------------------------------------------------------------------------
+    vector<T>& EmplaceBack(vector<vector<T>>& nested) {
+
+      if (spares.empty()) {
+        nested.emplace_back();
+      } else {
+        nested.push_back( move(spares.back()) );
+        spares.pop_back();
+      }
+      return nested.back();
+
+    }  // end 'EmplaceBack(vector<vector<T>>&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Resize a nested vector, using pool for inner vectors
+    // ------------------------------------------------------------------------
+    void Resize(vector<vector<T>>& nested, const size_t size) {
+
+      while (nested.size() > size) {
+        nested.back().clear();
+        spares.push_back( move(nested.back()) );
+        nested.pop_back();
+      }
+      while (nested.size() < size) {
+        EmplaceBack(nested);
+      }
+      return;
+
+    }  // end 'Resize(vector<vector<T>>&, size_t)'
+
+  };  // end SCorrelatorResponseMakerRecycler
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,255 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerAssign.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Sparse one-to-one assignment solver for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERASSIGN_H
+#define SCORRELATORRESPONSEMAKERASSIGN_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Sparse assignment of rows to columns
+  // --------------------------------------------------------------------------
+  /*! Finds the assignment of rows (truth jets) to
+   *  columns (reco jets) maximizing the total benefit,
+   *  where each column takes at most one row and rows
+   *  may be left unassigned. Only the allowed pairs are
+   *  stored, so the cost scales with the no. of
+   *  candidate pairs rather than rows x columns.
+   *
+   *  Solved with shortest augmenting paths (as in the
+   *  Hungarian method), adding one row at a time and
+   *  searching with a heap over the sparse edges. Each
+   *  row has a private zero-benefit column standing in
+   *  for "unassigned", so a path can always end there.
+   */
+  struct SCorrelatorResponseMakerAssigner {
+
+    // sparse benefit matrix
+    //   - n.b. costs are stored as -benefit
+    size_t          nCols = 0;
+    vector<int32_t> rowOffsets;
+    vector<int32_t> edgeCols;
+    vector<double>  edgeCosts;
+
+    // solution
+    //   - n.b. dummy columns are at nCols + iRow
+    vector<int32_t> col4row;
+    vector<int32_t> row4col;
+
+    // ------------------------------------------------------------------------
+    //! Reset matrix for a given no. of columns
+    // ------------------------------------------------------------------------
+    void Reset(const size_t nColsIn) {
+      nCols = nColsIn;
+      rowOffsets.assign(1, 0);
+      edgeCols.clear();
+      edgeCosts.clear();
+      col4row.clear();
+      row4col.clear();
+      return;
+    }  // end 'Reset(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of rows
+    // ------------------------------------------------------------------------
+    size_t GetNRows() const {
+      return rowOffsets.size() - 1;
+    }  // end 'GetNRows()'
+
+    // ------------------------------------------------------------------------
+    //! Start a new row
+    // ------------------------------------------------------------------------
+    size_t AddRow() {
+      rowOffsets.push_back(edgeCols.size());
+      return GetNRows() - 1;
+    }  // end 'AddRow()'
+
+    // ------------------------------------------------------------------------
+    //! Allow last row to take a column
+    // ------------------------------------------------------------------------
+    /*! Pairs with no positive benefit are never better
+     *  than leaving the row unassigned, so are dropped.
+     */
+    void AddEdge(const int32_t iCol, const double benefit) {
+      if (benefit <= 0.) return;
+      edgeCols.push_back(iCol);
+      edgeCosts.push_back(-benefit);
+      ++rowOffsets.back();
+      return;
+    }  // end 'AddEdge(int32_t, double)'
+
+    // ------------------------------------------------------------------------
+    //! Get column assigned to a row (-1 if none)
+    // ------------------------------------------------------------------------
+    int32_t GetCol(const size_t iRow) const {
+      const int32_t iCol = col4row[iRow];
+      return (iCol < (int32_t) nCols) ? iCol : -1;
+    }  // end 'GetCol(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Find optimal assignment
+    // ------------------------------------------------------------------------
+    void Solve() {
+
+      const size_t nRows    = GetNRows();
+      const size_t nAllCols = nCols + nRows;
+
+      // reset duals and solution
+      col4row.assign(nRows, -1);
+      row4col.assign(nAllCols, -1);
+      m_u.assign(nRows, 0.);
+      m_v.assign(nAllCols, 0.);
+      m_dist.assign(nAllCols, numeric_limits<double>::infinity());
+      m_path.assign(nAllCols, -1);
+      m_isScanned.assign(nAllCols, false);
+
+      // add rows one at a time
+      for (size_t iRow = 0; iRow < nRows; ++iRow) {
+        Augment(iRow);
+      }
+      return;
+
+    }  // end 'Solve()'
+
+    private:
+
+      // dual variables and search workspace
+      vector<double>  m_u;
+      vector<double>  m_v;
+      vector<double>  m_dist;
+      vector<int32_t> m_path;
+      vector<bool>    m_isScanned;
+      vector<int32_t> m_scannedRows;
+      vector<int32_t> m_touchedCols;
+
+      // search heap entries
+      //   - n.b. on ties, free columns come first and then
+      //     lower indices, so the result is deterministic
+      struct Node {
+        double  dist   = 0.;
+        bool    isUsed = false;
+        int32_t iCol   = -1;
+        bool operator>(const Node& rhs) const {
+          if (dist != rhs.dist)     return dist > rhs.dist;
+          if (isUsed != rhs.isUsed) return isUsed;
+          return iCol > rhs.iCol;
+        }
+      };
+      vector<Node> m_heap;
+
+      // ----------------------------------------------------------------------
+      //! Relax edges of a row, including its dummy column
+      // ----------------------------------------------------------------------
+      void Relax(const int32_t iRow, const double minDist) {
+
+        auto relax = [&](const int32_t iCol, const double cost) {
+          if (m_isScanned[iCol]) return;
+          const double dist = minDist + cost - m_u[iRow] - m_v[iCol];
+          if (dist >= m_dist[iCol]) return;
+          if (m_dist[iCol] == numeric_limits<double>::infinity()) {
+            m_touchedCols.push_back(iCol);
+          }
+          m_dist[iCol] = dist;
+          m_path[iCol] = iRow;
+          m_heap.push_back( {dist, (row4col[iCol] >= 0), iCol} );
+          push_heap(m_heap.begin(), m_heap.end(), greater<Node>());
+        };
+
+        for (int32_t iEdge = rowOffsets[iRow]; iEdge < rowOffsets[iRow + 1]; ++iEdge) {
+          relax(edgeCols[iEdge], edgeCosts[iEdge]);
+        }
+        relax(nCols + iRow, 0.);
+        return;
+
+      }  // end 'Relax(int32_t, double)'
+
+      // ----------------------------------------------------------------------
+      //! Add a row along the shortest augmenting path
+      // ----------------------------------------------------------------------
+      void Augment(const int32_t iStart) {
+
+        // grow shortest-path tree until a free column is reached
+        //   - n.b. the start row's dummy column is always free,
+        //     so a path is always found
+        m_heap.clear();
+        m_scannedRows.clear();
+        m_touchedCols.clear();
+
+        int32_t iRow    = iStart;
+        int32_t iSink   = -1;
+        double  minDist = 0.;
+        while (iSink < 0) {
+
+          m_scannedRows.push_back(iRow);
+          Relax(iRow, minDist);
+
+          // pop closest unscanned column
+          int32_t iCol = -1;
+          while (!m_heap.empty()) {
+            pop_heap(m_heap.begin(), m_heap.end(), greater<Node>());
+            const Node node = m_heap.back();
+            m_heap.pop_back();
+            if (m_isScanned[node.iCol] || (node.dist != m_dist[node.iCol])) continue;
+            iCol = node.iCol;
+            break;
+          }
+          minDist           = m_dist[iCol];
+          m_isScanned[iCol] = true;
+
+          // stop if free, otherwise continue from its row
+          if (row4col[iCol] < 0) {
+            iSink = iCol;
+          } else {
+            iRow = row4col[iCol];
+          }
+        }
+
+        // update duals
+        m_u[iStart] += minDist;
+        for (const int32_t iScanned : m_scannedRows) {
+          if (iScanned == iStart) continue;
+          m_u[iScanned] += minDist - m_dist[col4row[iScanned]];
+        }
+        for (const int32_t iTouched : m_touchedCols) {
+          if (m_isScanned[iTouched]) {
+            m_v[iTouched] -= minDist - m_dist[iTouched];
+          }
+        }
+
+        // flip assignments along path
+        int32_t iCol = iSink;
+        while (true) {
+          const int32_t iPathRow = m_path[iCol];
+          row4col[iCol] = iPathRow;
+          swap(col4row[iPathRow], iCol);
+          if (iPathRow == iStart) break;
+        }
+
+        // and clear workspace
+        for (const int32_t iTouched : m_touchedCols) {
+          m_dist[iTouched]      = numeric_limits<double>::infinity();
+          m_isScanned[iTouched] = false;
+        }
+        return;
+
+      }  // end 'Augment(int32_t)'
+
+  };  // end SCorrelatorResponseMakerAssigner
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
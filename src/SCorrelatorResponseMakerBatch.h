@@ -0,0 +1,274 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerBatch.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Cross-event batch of inputs for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERBATCH_H
+#define SCORRELATORRESPONSEMAKERBATCH_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Candidate reco jet of a truth jet in a batch
+  // --------------------------------------------------------------------------
+  struct SCorrelatorResponseMakerBatchPair {
+
+    int32_t iRecoJet = -1;
+    double  dr       = numeric_limits<double>::max();
+    double  qt       = numeric_limits<double>::max();
+
+  };  // end SCorrelatorResponseMakerBatchPair
+
+
+
+  // --------------------------------------------------------------------------
+  //! Batch of events
+  // --------------------------------------------------------------------------
+  /*! Holds the inputs of several consecutive events,
+   *  with the jets of all of them laid out in one block
+   *  of arrays (each event a segment, starting at its
+   *  offset). Jet acceptance and the dr/qt windows are
+   *  then evaluated over every truth-reco pair in the
+   *  batch at once, rather than over the few pairs of
+   *  each event, and the pairs passing are looked up
+   *  per event when matching.
+   *
+   *  Inputs are swapped in and out rather than copied,
+   *  so the slots share the memory resource of the
+   *  inputs they're swapped with.
+   */
+  struct SCorrelatorResponseMakerBatch {
+
+    // events in batch
+    //   - n.b. slots are kept between batches, so
+    //     there can be more slots than events
+    size_t                                     nEvts = 0;
+    vector<uint64_t>                           entries;
+    vector<SCorrelatorResponseMakerTruthInput> trueInputs;
+    vector<SCorrelatorResponseMakerRecoInput>  recoInputs;
+
+    // jet blocks
+    vector<uint32_t> trueOffsets;
+    vector<double>   trueEta;
+    vector<double>   truePhi;
+    vector<double>   truePT;
+    vector<uint8_t>  isTrueGood;
+    vector<uint32_t> recoOffsets;
+    vector<double>   recoEta;
+    vector<double>   recoPhi;
+    vector<double>   recoPT;
+    vector<uint8_t>  isRecoGood;
+
+    // every good truth-reco pair in the same event
+    vector<uint32_t> pairOffsets;
+    vector<int32_t>  pairReco;
+    vector<double>   pairDEta;
+    vector<double>   pairDPhi;
+    vector<double>   pairTruePT;
+    vector<double>   pairRecoPT;
+    vector<double>   pairDr2;
+    vector<double>   pairQt;
+
+    // pairs passing cuts
+    vector<uint32_t>                          candOffsets;
+    vector<SCorrelatorResponseMakerBatchPair> cands;
+
+    // ------------------------------------------------------------------------
+    //! Reset batch
+    // ------------------------------------------------------------------------
+    /*! Empties the inputs held by the slots, so must be
+     *  called before the memory they use is reclaimed.
+     */
+    void Reset() {
+      for (size_t iEvt = 0; iEvt < nEvts; ++iEvt) {
+        trueInputs[iEvt].Reset();
+        recoInputs[iEvt].Reset();
+      }
+      nEvts = 0;
+      entries.clear();
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Move an event into the batch
+    // ------------------------------------------------------------------------
+    /*! The inputs passed in are left with the empty
+     *  containers of the slot.
+     */
+    void AddEvent(
+      const uint64_t entry,
+      SCorrelatorResponseMakerTruthInput& truth,
+      SCorrelatorResponseMakerRecoInput& reco
+    ) {
+
+      if (nEvts == trueInputs.size()) {
+        trueInputs.emplace_back(truth.jets.get_allocator().resource());
+        recoInputs.emplace_back(reco.jets.get_allocator().resource());
+      }
+      swap(trueInputs[nEvts], truth);
+      swap(recoInputs[nEvts], reco);
+      entries.push_back(entry);
+      ++nEvts;
+      return;
+
+    }  // end 'AddEvent(uint64_t, SCorrelatorResponseMakerTruthInput&, SCorrelatorResponseMakerRecoInput&)'
+
+    // ------------------------------------------------------------------------
+    //! Swap an event with the inputs passed in
+    // ------------------------------------------------------------------------
+    void SwapEvent(
+      const size_t iEvt,
+      SCorrelatorResponseMakerTruthInput& truth,
+      SCorrelatorResponseMakerRecoInput& reco
+    ) {
+      swap(trueInputs[iEvt], truth);
+      swap(recoInputs[iEvt], reco);
+      return;
+    }  // end 'SwapEvent(size_t, SCorrelatorResponseMakerTruthInput&, SCorrelatorResponseMakerRecoInput&)'
+
+    // ------------------------------------------------------------------------
+    //! Lay out jets of all events and apply acceptance
+    // ------------------------------------------------------------------------
+    template <typename F> void Build(F isGoodJetFn) {
+
+      trueOffsets.assign(1, 0);
+      recoOffsets.assign(1, 0);
+      trueEta.clear();
+      truePhi.clear();
+      truePT.clear();
+      isTrueGood.clear();
+      recoEta.clear();
+      recoPhi.clear();
+      recoPT.clear();
+      isRecoGood.clear();
+      for (size_t iEvt = 0; iEvt < nEvts; ++iEvt) {
+        for (const Types::JetInfo& jet : trueInputs[iEvt].jets) {
+          trueEta.push_back( jet.GetEta() );
+          truePhi.push_back( jet.GetPhi() );
+          truePT.push_back( jet.GetPT() );
+          isTrueGood.push_back( isGoodJetFn(jet) );
+        }
+        for (const Types::JetInfo& jet : recoInputs[iEvt].jets) {
+          recoEta.push_back( jet.GetEta() );
+          recoPhi.push_back( jet.GetPhi() );
+          recoPT.push_back( jet.GetPT() );
+          isRecoGood.push_back( isGoodJetFn(jet) );
+        }
+        trueOffsets.push_back( trueEta.size() );
+        recoOffsets.push_back( recoEta.size() );
+      }
+      return;
+
+    }  // end 'Build(F)'
+
+    // ------------------------------------------------------------------------
+    //! Find truth-reco pairs passing the dr/qt windows
+    // ------------------------------------------------------------------------
+    /*! Pairs of good jets are first laid out
+     *  contiguously, so that the windows can be checked
+     *  in one vectorizable loop over every pair in the
+     *  batch. Pairs failing are flagged with a
+     *  negative dr^2.
+     *
+     *  n.b. phi differences are folded into [0, pi],
+     *  which assumes phi is within a 2pi range.
+     */
+    void FindPairs(const pair<double, double>& drRange, const pair<double, double>& qtRange) {
+
+      // lay out pairs
+      pairOffsets.assign(1, 0);
+      pairReco.clear();
+      pairDEta.clear();
+      pairDPhi.clear();
+      pairTruePT.clear();
+      pairRecoPT.clear();
+      for (size_t iEvt = 0; iEvt < nEvts; ++iEvt) {
+        for (uint32_t iTrue = trueOffsets[iEvt]; iTrue < trueOffsets[iEvt + 1]; ++iTrue) {
+          for (uint32_t iReco = recoOffsets[iEvt]; iReco < recoOffsets[iEvt + 1]; ++iReco) {
+            if (!isTrueGood[iTrue] || !isRecoGood[iReco]) continue;
+            pairReco.push_back( iReco - recoOffsets[iEvt] );
+            pairDEta.push_back( trueEta[iTrue] - recoEta[iReco] );
+            pairDPhi.push_back( truePhi[iTrue] - recoPhi[iReco] );
+            pairTruePT.push_back( truePT[iTrue] );
+            pairRecoPT.push_back( recoPT[iReco] );
+          }
+          pairOffsets.push_back( pairReco.size() );
+        }
+      }
+
+      // check windows
+      const size_t nPairs = pairReco.size();
+      const double drMin  = max(drRange.first, 0.);
+      const double dr2Min = drMin * drMin;
+      const double dr2Max = (drRange.second >= 0.) ? (drRange.second * drRange.second) : -1.;
+      const double qtMin  = qtRange.first;
+      const double qtMax  = qtRange.second;
+      pairDr2.resize(nPairs);
+      pairQt.resize(nPairs);
+
+      const double*  dEta   = pairDEta.data();
+      const double*  dPhi   = pairDPhi.data();
+      const double*  truePt = pairTruePT.data();
+      const double*  recoPt = pairRecoPT.data();
+      double*        dr2    = pairDr2.data();
+      double*        qt     = pairQt.data();
+      #pragma omp simd
+      for (size_t iPair = 0; iPair < nPairs; ++iPair) {
+        const double absPhi  = abs(dPhi[iPair]);
+        const double foldPhi = min(absPhi, (2. * M_PI) - absPhi);
+        const double pairDr2 = (dEta[iPair] * dEta[iPair]) + (foldPhi * foldPhi);
+        const double pairQt  = recoPt[iPair] / truePt[iPair];
+        const bool   isIn    = (pairDr2 >= dr2Min) & (pairDr2 <= dr2Max) & (pairQt >= qtMin) & (pairQt <= qtMax);
+        dr2[iPair] = isIn ? pairDr2 : -1.;
+        qt[iPair]  = pairQt;
+      }
+
+      // and collect pairs passing
+      candOffsets.assign(1, 0);
+      cands.clear();
+      for (size_t iTrue = 0; iTrue + 1 < pairOffsets.size(); ++iTrue) {
+        for (uint32_t iPair = pairOffsets[iTrue]; iPair < pairOffsets[iTrue + 1]; ++iPair) {
+          if (pairDr2[iPair] < 0.) continue;
+          cands.push_back( {pairReco[iPair], sqrt(pairDr2[iPair]), pairQt[iPair]} );
+        }
+        candOffsets.push_back( cands.size() );
+      }
+      return;
+
+    }  // end 'FindPairs(pair<double, double>&, pair<double, double>&)'
+
+    // ------------------------------------------------------------------------
+    //! Check if a truth jet of an event passed acceptance
+    // ------------------------------------------------------------------------
+    bool IsTrueGood(const size_t iEvt, const size_t iTrueJet) const {
+      return isTrueGood[trueOffsets[iEvt] + iTrueJet];
+    }  // end 'IsTrueGood(size_t, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get range of pairs passing for a truth jet of an event
+    // ------------------------------------------------------------------------
+    pair<const SCorrelatorResponseMakerBatchPair*, const SCorrelatorResponseMakerBatchPair*> GetCands(
+      const size_t iEvt,
+      const size_t iTrueJet
+    ) const {
+      const size_t iTrue = trueOffsets[iEvt] + iTrueJet;
+      return {cands.data() + candOffsets[iTrue], cands.data() + candOffsets[iTrue + 1]};
+    }  // end 'GetCands(size_t, size_t)'
+
+  };  // end SCorrelatorResponseMakerBatch
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
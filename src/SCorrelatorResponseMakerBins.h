@@ -0,0 +1,235 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerBins.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Jet pt (x eta) binning of the output of the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERBINS_H
+#define SCORRELATORRESPONSEMAKERBINS_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Jet pt (x eta) bins of output
+  // --------------------------------------------------------------------------
+  /*! Bins are numbered pt-major, i.e. bin = (iPt * nEta)
+   *  + iEta. Binning is off unless there are at least 2
+   *  pt edges, and eta isn't binned unless there are at
+   *  least 2 eta edges. Jets outside of the edges aren't
+   *  in any bin.
+   *
+   *  Each bin is written to its own tree, and the bin
+   *  index (a tree with one entry per bin) records the
+   *  edges, tree name, and no. of entries of each, so a
+   *  reader can go straight to the tree of the bin it
+   *  needs.
+   */
+  struct SCorrelatorResponseMakerBinning {
+
+    // bin edges
+    vector<double> ptEdges;
+    vector<double> etaEdges;
+
+    // ------------------------------------------------------------------------
+    //! Get no. of bins (0 if binning is off)
+    // ------------------------------------------------------------------------
+    size_t GetNBins() const {
+      return (ptEdges.size() < 2) ? 0 : (ptEdges.size() - 1) * GetNEtaBins();
+    }  // end 'GetNBins()'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of eta bins (1 if eta isn't binned)
+    // ------------------------------------------------------------------------
+    size_t GetNEtaBins() const {
+      return (etaEdges.size() < 2) ? 1 : (etaEdges.size() - 1);
+    }  // end 'GetNEtaBins()'
+
+    // ------------------------------------------------------------------------
+    //! Find bin of a jet (-1 if outside of edges)
+    // ------------------------------------------------------------------------
+    int32_t GetBin(const double pt, const double eta) const {
+
+      const int32_t iPt = FindEdge(ptEdges, pt);
+      if (iPt < 0) return -1;
+      if (etaEdges.size() < 2) return iPt;
+
+      const int32_t iEta = FindEdge(etaEdges, eta);
+      if (iEta < 0) return -1;
+      return (iPt * GetNEtaBins()) + iEta;
+
+    }  // end 'GetBin(double, double)'
+
+    // ------------------------------------------------------------------------
+    //! Get pt range of a bin
+    // ------------------------------------------------------------------------
+    pair<double, double> GetPtRange(const size_t iBin) const {
+      const size_t iPt = iBin / GetNEtaBins();
+      return {ptEdges[iPt], ptEdges[iPt + 1]};
+    }  // end 'GetPtRange(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get eta range of a bin (unbounded if eta isn't binned)
+    // ------------------------------------------------------------------------
+    pair<double, double> GetEtaRange(const size_t iBin) const {
+      if (etaEdges.size() < 2) {
+        return {-numeric_limits<double>::infinity(), numeric_limits<double>::infinity()};
+      }
+      const size_t iEta = iBin % GetNEtaBins();
+      return {etaEdges[iEta], etaEdges[iEta + 1]};
+    }  // end 'GetEtaRange(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Check that edges are strictly increasing
+    // ------------------------------------------------------------------------
+    /*! Needed to look bins up by bisection. Lists of less
+     *  than 2 edges (i.e. not binned) are always fine.
+     */
+    bool IsValid() const {
+
+      const auto isIncreasing = [](const vector<double>& edges) {
+        return adjacent_find(edges.begin(), edges.end(), greater_equal<double>()) == edges.end();
+      };
+      return isIncreasing(ptEdges) && isIncreasing(etaEdges);
+
+    }  // end 'IsValid()'
+
+    // ------------------------------------------------------------------------
+    //! Get name of tree of a bin
+    // ------------------------------------------------------------------------
+    string GetTreeName(const size_t iBin) const {
+      return "ResponseTree_bin" + to_string(iBin);
+    }  // end 'GetTreeName(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Write bin index to a file
+    // ------------------------------------------------------------------------
+    void WriteIndex(TFile* file, const vector<TTree*>& trees) const {
+
+      file -> cd();
+
+      int32_t iBin     = 0;
+      double  ptMin    = 0.;
+      double  ptMax    = 0.;
+      double  etaMin   = 0.;
+      double  etaMax   = 0.;
+      int64_t nEntries = 0;
+      string  treeName = "";
+
+      TTree* index = new TTree("ResponseBinIndex", "Jet pt (x eta) bins of response trees");
+      index -> Branch("BinID",    &iBin,     "BinID/I");
+      index -> Branch("PtMin",    &ptMin,    "PtMin/D");
+      index -> Branch("PtMax",    &ptMax,    "PtMax/D");
+      index -> Branch("EtaMin",   &etaMin,   "EtaMin/D");
+      index -> Branch("EtaMax",   &etaMax,   "EtaMax/D");
+      index -> Branch("NEntries", &nEntries, "NEntries/L");
+      index -> Branch("TreeName", &treeName);
+      for (size_t iTree = 0; iTree < trees.size(); ++iTree) {
+        iBin     = iTree;
+        ptMin    = GetPtRange(iTree).first;
+        ptMax    = GetPtRange(iTree).second;
+        etaMin   = GetEtaRange(iTree).first;
+        etaMax   = GetEtaRange(iTree).second;
+        nEntries = trees[iTree] -> GetEntries();
+        treeName = trees[iTree] -> GetName();
+        index -> Fill();
+      }
+      index -> Write();
+      return;
+
+    }  // end 'WriteIndex(TFile*, vector<TTree*>&)'
+
+    // ------------------------------------------------------------------------
+    //! Get tree of the bin a jet falls in from a file
+    // ------------------------------------------------------------------------
+    /*! Looks the bin up in the bin index of the file.
+     *  Returns NULL if there's no index or the jet isn't
+     *  in any bin.
+     */
+    static TTree* GetBinTree(TFile* file, const double pt, const double eta) {
+
+      TTree* index = NULL;
+      file -> GetObject("ResponseBinIndex", index);
+      if (!index) return NULL;
+
+      double  ptMin    = 0.;
+      double  ptMax    = 0.;
+      double  etaMin   = 0.;
+      double  etaMax   = 0.;
+      string* treeName = NULL;
+      index -> SetBranchAddress("PtMin",    &ptMin);
+      index -> SetBranchAddress("PtMax",    &ptMax);
+      index -> SetBranchAddress("EtaMin",   &etaMin);
+      index -> SetBranchAddress("EtaMax",   &etaMax);
+      index -> SetBranchAddress("TreeName", &treeName);
+
+      TTree* tree = NULL;
+      for (int64_t iBin = 0; iBin < index -> GetEntries(); ++iBin) {
+        index -> GetEntry(iBin);
+        const bool isInPt  = (pt >= ptMin)   && (pt < ptMax);
+        const bool isInEta = (eta >= etaMin) && (eta < etaMax);
+        if (isInPt && isInEta) {
+          file -> GetObject(treeName -> data(), tree);
+          break;
+        }
+      }
+      index -> ResetBranchAddresses();
+      delete treeName;
+      return tree;
+
+    }  // end 'GetBinTree(TFile*, double, double)'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of entries each bin tree should have
+    // ------------------------------------------------------------------------
+    /*! i.e. one past the last entry of each bin recorded
+     *  in BinEntries of the main tree (0 if none). The
+     *  main tree is scanned back from its last entry
+     *  until every bin has been seen.
+     */
+    static vector<int64_t> GetNExpected(TTree* main, const size_t nBins) {
+
+      vector<int64_t>  nExpect(nBins, 0);
+      vector<int64_t>* binEntries = NULL;
+      main -> SetBranchAddress("BinEntries", &binEntries);
+
+      size_t nFound = 0;
+      for (int64_t iEntry = main -> GetEntries() - 1; (iEntry >= 0) && (nFound < nBins); --iEntry) {
+        main -> GetEntry(iEntry);
+        for (size_t iBin = 0; iBin < min(nBins, binEntries -> size()); ++iBin) {
+          if ((nExpect[iBin] > 0) || ((*binEntries)[iBin] < 0)) continue;
+          nExpect[iBin] = (*binEntries)[iBin] + 1;
+          ++nFound;
+        }
+      }
+      main -> ResetBranchAddresses();
+      delete binEntries;
+      return nExpect;
+
+    }  // end 'GetNExpected(TTree*, size_t)'
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Find bin of a value in a list of edges (-1 if outside)
+      // ----------------------------------------------------------------------
+      static int32_t FindEdge(const vector<double>& edges, const double value) {
+        if ((value < edges.front()) || (value >= edges.back())) return -1;
+        return (upper_bound(edges.begin(), edges.end(), value) - edges.begin()) - 1;
+      }  // end 'FindEdge(vector<double>&, double)'
+
+  };  // end SCorrelatorResponseMakerBinning
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,509 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerCache.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Per-event candidate cache for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERCACHE_H
+#define SCORRELATORRESPONSEMAKERCACHE_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Constituent ID and index
+  // --------------------------------------------------------------------------
+  /*! Sorting a list of these by ID (stably, so that
+   *  constituents with the same ID stay in index
+   *  order) allows two lists to be merge-joined.
+   */
+  struct SCorrelatorResponseMakerCstKey {
+
+    int32_t id    = -1;
+    int32_t index = -1;
+
+    // ------------------------------------------------------------------------
+    //! Sort keys by ID
+    // ------------------------------------------------------------------------
+    template <typename T> static void Sort(T begin, T end) {
+
+      stable_sort(
+        begin,
+        end,
+        [](const SCorrelatorResponseMakerCstKey& lhs, const SCorrelatorResponseMakerCstKey& rhs) {
+          return (lhs.id < rhs.id);
+        }
+      );
+      return;
+
+    }  // end 'Sort(T, T)'
+
+  };  // end SCorrelatorResponseMakerCstKey
+
+
+
+  // --------------------------------------------------------------------------
+  //! Candidate reco jet for a truth jet
+  // --------------------------------------------------------------------------
+  /*! Bound is the largest fraction of truth csts the
+   *  reco jet could match, i.e. min(no. of good truth
+   *  csts, no. of good reco csts) / no. of good truth
+   *  csts. Candidates are searched in order of
+   *  decreasing bound and then increasing delta-r.
+   */
+  struct SCorrelatorResponseMakerCandidate {
+
+    int32_t iJet      = -1;
+    double  bound     = 0.;
+    double  dr        = 0.;
+    double  qt        = 0.;
+    bool    isClaimed = false;
+
+    // ------------------------------------------------------------------------
+    //! Order in which candidates are searched
+    // ------------------------------------------------------------------------
+    bool operator<(const SCorrelatorResponseMakerCandidate& other) const {
+      if (bound != other.bound) return (bound > other.bound);
+      if (dr != other.dr)       return (dr < other.dr);
+      return (iJet < other.iJet);
+    }  // end 'operator<(SCorrelatorResponseMakerCandidate&)'
+
+  };  // end SCorrelatorResponseMakerCandidate
+
+
+
+  // --------------------------------------------------------------------------
+  //! Per-event cache of reco candidates
+  // --------------------------------------------------------------------------
+  /*! The reco side of an event is the same for every
+   *  truth jet, so the acceptance cuts, constituent
+   *  IDs and jet kinematics are evaluated once per event
+   *  and kept in flat arrays. The good constituents of
+   *  reco jet i are at [offsets[i], offsets[i + 1]).
+   *
+   *  How candidates are looked up depends on the index
+   *  built for the event:
+   *    - Brute: csts are left in their original order
+   *      and every jet is a candidate;
+   *    - Hash: as brute, plus a hash of cst id to the
+   *      csts with that id, so the overlap of a truth
+   *      jet with every reco jet is found in one pass;
+   *    - Grid: csts are sorted by id (with bitsets if
+   *      ids are dense enough that a bitset per jet
+   *      takes about as much memory as the id lists)
+   *      and jets are binned in an eta-phi grid.
+   *  Storage is only grown, never released.
+   */
+  struct SCorrelatorResponseMakerRecoCache {
+
+    // types of index
+    enum Index {Brute, Hash, Grid, NIndices};
+
+    // jet kinematics and cuts
+    vector<uint8_t> isGoodJet;
+    vector<double>  pt;
+    vector<double>  eta;
+    vector<double>  phi;
+
+    // good csts (sorted by id within each jet if grid)
+    Index           index    = Grid;
+    bool            isSorted = true;
+    vector<int32_t> offsets;
+    vector<int32_t> cstIDs;
+    vector<int32_t> cstIndices;
+    vector<int32_t> cstJets;
+
+    // id hash (chains of csts per bucket)
+    uint32_t        hashMask = 0;
+    vector<int32_t> hashHeads;
+    vector<int32_t> hashNext;
+
+    // jet grid (chains of jets per cell)
+    double          gridEtaMin  = 0.;
+    double          gridEtaCell = 0.;
+    double          gridPhiCell = 0.;
+    int32_t         nEtaCells   = 0;
+    int32_t         nPhiCells   = 0;
+    vector<int32_t> gridHeads;
+    vector<int32_t> gridNext;
+
+    // dense id bitsets (nWords per jet)
+    bool             isDense = false;
+    int64_t          minID   = 0;
+    size_t           nWords  = 0;
+    vector<uint64_t> bits;
+
+    // scratch space for sorting
+    vector<SCorrelatorResponseMakerCstKey> keys;
+
+    // max ratio of bitset words to csts
+    static constexpr size_t maxWordsPerCst = 4;
+
+    // max no. of grid cells in eta
+    static constexpr int32_t maxEtaCells = 1024;
+
+    // ------------------------------------------------------------------------
+    //! Fill cache for an event
+    // ------------------------------------------------------------------------
+    template <typename J, typename C, typename F, typename G> void Build(
+      const J& jets,
+      const C& csts,
+      F isGoodJetFn,
+      G isGoodCstFn,
+      const Index type = Grid,
+      const double cellSize = 0.4
+    ) {
+
+      Reset();
+      index    = type;
+      isSorted = (type == Grid);
+
+      const size_t nJets = jets.size();
+      isGoodJet.resize(nJets);
+      pt.resize(nJets);
+      eta.resize(nJets);
+      phi.resize(nJets);
+      offsets.push_back(0);
+      for (size_t iJet = 0; iJet < nJets; ++iJet) {
+
+        // cache jet kinematics and cut
+        isGoodJet[iJet] = isGoodJetFn(jets[iJet]);
+        pt[iJet]        = jets[iJet].GetPT();
+        eta[iJet]       = jets[iJet].GetEta();
+        phi[iJet]       = jets[iJet].GetPhi();
+
+        // collect good csts of good jets
+        keys.clear();
+        if (isGoodJet[iJet]) {
+          for (size_t iCst = 0; iCst < csts[iJet].size(); ++iCst) {
+            if (!isGoodCstFn(csts[iJet][iCst])) continue;
+            keys.push_back( {csts[iJet][iCst].GetCstID(), (int32_t) iCst} );
+          }
+        }
+
+        // and sort by id if needed
+        if (isSorted) {
+          SCorrelatorResponseMakerCstKey::Sort(keys.begin(), keys.end());
+        }
+        for (const SCorrelatorResponseMakerCstKey& key : keys) {
+          cstIDs.push_back(key.id);
+          cstIndices.push_back(key.index);
+          cstJets.push_back(iJet);
+        }
+        offsets.push_back(cstIDs.size());
+      }
+
+      // build index
+      switch (index) {
+        case Hash:
+          BuildHash();
+          break;
+        case Grid:
+          BuildBitsets();
+          BuildGrid(cellSize);
+          break;
+        default:
+          break;
+      }
+      return;
+
+    }  // end 'Build(J&, C&, F, G, Index, double)'
+
+    // ------------------------------------------------------------------------
+    //! Fill hash of cst ids
+    // ------------------------------------------------------------------------
+    /*! Csts are chained in reverse so that each chain
+     *  runs in increasing order of flat index, i.e. jet
+     *  by jet.
+     */
+    void BuildHash() {
+
+      // size table to next power of 2 above twice the no. of csts
+      uint32_t nBuckets = 16;
+      while (nBuckets < (2 * cstIDs.size())) nBuckets <<= 1;
+      hashMask = nBuckets - 1;
+
+      hashHeads.assign(nBuckets, -1);
+      hashNext.resize(cstIDs.size());
+      for (int32_t iFlat = cstIDs.size() - 1; iFlat >= 0; --iFlat) {
+        const uint32_t bucket = GetBucket(cstIDs[iFlat]);
+        hashNext[iFlat]   = hashHeads[bucket];
+        hashHeads[bucket] = iFlat;
+      }
+      return;
+
+    }  // end 'BuildHash()'
+
+    // ------------------------------------------------------------------------
+    //! Check if a cell size splits the grid into more than one cell
+    // ------------------------------------------------------------------------
+    /*! Otherwise every jet lands in the same phi cell,
+     *  and the grid is no better than a scan.
+     */
+    static bool IsCellSizeUseful(const double cellSize) {
+      return (cellSize > 0.) && (cellSize < M_PI);
+    }  // end 'IsCellSizeUseful(double)'
+
+    // ------------------------------------------------------------------------
+    //! Fill eta-phi grid of good jets
+    // ------------------------------------------------------------------------
+    void BuildGrid(const double cellSize) {
+
+      // get range of eta
+      double etaMax = numeric_limits<double>::lowest();
+      gridEtaMin    = numeric_limits<double>::max();
+      for (size_t iJet = 0; iJet < GetNJets(); ++iJet) {
+        if (!isGoodJet[iJet]) continue;
+        gridEtaMin = min(gridEtaMin, eta[iJet]);
+        etaMax     = max(etaMax, eta[iJet]);
+      }
+      if (etaMax < gridEtaMin) {
+        nEtaCells = 0;
+        nPhiCells = 0;
+        return;
+      }
+
+      // size cells
+      //   - n.b. phi cells are stretched to evenly divide 2pi
+      const bool isCellGood = IsCellSizeUseful(cellSize);
+      nPhiCells   = isCellGood ? max(1, (int32_t) floor(2. * M_PI / cellSize)) : 1;
+      gridPhiCell = 2. * M_PI / nPhiCells;
+      gridEtaCell = isCellGood ? cellSize : max(etaMax - gridEtaMin, 1.);
+      nEtaCells   = ((etaMax - gridEtaMin) / gridEtaCell) + 1;
+      if (nEtaCells > maxEtaCells) {
+        gridEtaCell = (etaMax - gridEtaMin) / (maxEtaCells - 1);
+        nEtaCells   = maxEtaCells;
+      }
+
+      // and fill
+      gridHeads.assign(nEtaCells * nPhiCells, -1);
+      gridNext.assign(GetNJets(), -1);
+      for (int32_t iJet = GetNJets() - 1; iJet >= 0; --iJet) {
+        if (!isGoodJet[iJet]) continue;
+        const int32_t iEta  = min(max(GetEtaCell(eta[iJet]), 0), nEtaCells - 1);
+        const int32_t iCell = (iEta * nPhiCells) + GetPhiCell(phi[iJet]);
+        gridNext[iJet]   = gridHeads[iCell];
+        gridHeads[iCell] = iJet;
+      }
+      return;
+
+    }  // end 'BuildGrid(double)'
+
+    // ------------------------------------------------------------------------
+    //! Fill bitsets if ids are dense
+    // ------------------------------------------------------------------------
+    void BuildBitsets() {
+
+      isDense = false;
+      if (cstIDs.empty()) return;
+
+      // get range of ids
+      const auto range = minmax_element(cstIDs.begin(), cstIDs.end());
+      minID  = *range.first;
+      nWords = ((*range.second - minID) / 64) + 1;
+
+      // check if dense enough
+      const size_t nJets = GetNJets();
+      if ((nJets * nWords) > (maxWordsPerCst * cstIDs.size())) return;
+
+      // and set bits
+      isDense = true;
+      bits.assign(nJets * nWords, 0);
+      for (size_t iJet = 0; iJet < nJets; ++iJet) {
+        uint64_t* jetBits = bits.data() + (iJet * nWords);
+        for (int32_t iCst = offsets[iJet]; iCst < offsets[iJet + 1]; ++iCst) {
+          const uint64_t iBit = cstIDs[iCst] - minID;
+          jetBits[iBit / 64] |= (uint64_t(1) << (iBit % 64));
+        }
+      }
+      return;
+
+    }  // end 'BuildBitsets()'
+
+    // ------------------------------------------------------------------------
+    //! Reset cache
+    // ------------------------------------------------------------------------
+    void Reset() {
+      isGoodJet.clear();
+      pt.clear();
+      eta.clear();
+      phi.clear();
+      offsets.clear();
+      cstIDs.clear();
+      cstIndices.clear();
+      keys.clear();
+      bits.clear();
+      isDense = false;
+      cstJets.clear();
+      hashHeads.clear();
+      hashNext.clear();
+      gridHeads.clear();
+      gridNext.clear();
+      nEtaCells = 0;
+      nPhiCells = 0;
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of jets in cache
+    // ------------------------------------------------------------------------
+    size_t GetNJets() const {
+      return isGoodJet.size();
+    }  // end 'GetNJets()'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of good csts in a jet
+    // ------------------------------------------------------------------------
+    size_t GetNCsts(const size_t iJet) const {
+      return offsets[iJet + 1] - offsets[iJet];
+    }  // end 'GetNCsts(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get hash bucket of an id
+    // ------------------------------------------------------------------------
+    uint32_t GetBucket(const int32_t id) const {
+      return ((uint32_t) id * 2654435761u) & hashMask;
+    }  // end 'GetBucket(int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get grid cell of an eta, phi
+    // ------------------------------------------------------------------------
+    int32_t GetEtaCell(const double etaIn) const {
+      return (int32_t) floor((etaIn - gridEtaMin) / gridEtaCell);
+    }  // end 'GetEtaCell(double)'
+
+    int32_t GetPhiCell(const double phiIn) const {
+      const double phiWrap = phiIn - (2. * M_PI * floor(phiIn / (2. * M_PI)));
+      return min((int32_t) (phiWrap / gridPhiCell), nPhiCells - 1);
+    }  // end 'GetPhiCell(double)'
+
+    // ------------------------------------------------------------------------
+    //! Call fn(iJet) for every jet which could be within dr
+    // ------------------------------------------------------------------------
+    /*! With a grid, only good jets in cells within dr
+     *  are visited; otherwise every jet is.
+     */
+    template <typename F> void ForEachNearJet(const double etaIn, const double phiIn, const double dr, F fn) const {
+
+      if (index != Grid) {
+        for (size_t iJet = 0; iJet < GetNJets(); ++iJet) fn(iJet);
+        return;
+      }
+      if ((nEtaCells == 0) || (nPhiCells == 0)) return;
+
+      // get range of cells to visit
+      //   - n.b. if the phi range covers every cell, each
+      //     is visited once
+      const int32_t nEtaSpan = (int32_t) ceil(dr / gridEtaCell);
+      const int32_t nPhiSpan = (int32_t) ceil(dr / gridPhiCell);
+      const int32_t iEta     = GetEtaCell(etaIn);
+      const int32_t iPhi     = GetPhiCell(phiIn);
+      const int32_t etaStart = max(0, iEta - nEtaSpan);
+      const int32_t etaStop  = min(nEtaCells - 1, iEta + nEtaSpan);
+      const bool    isAllPhi = ((2 * nPhiSpan) + 1) >= nPhiCells;
+      const int32_t phiStart = isAllPhi ? 0 : iPhi - nPhiSpan;
+      const int32_t phiStop  = isAllPhi ? nPhiCells - 1 : iPhi + nPhiSpan;
+      for (int32_t iEtaCell = etaStart; iEtaCell <= etaStop; ++iEtaCell) {
+        for (int32_t iPhiCell = phiStart; iPhiCell <= phiStop; ++iPhiCell) {
+          const int32_t iWrap = ((iPhiCell % nPhiCells) + nPhiCells) % nPhiCells;
+          for (int32_t iJet = gridHeads[(iEtaCell * nPhiCells) + iWrap]; iJet >= 0; iJet = gridNext[iJet]) {
+            fn(iJet);
+          }
+        }
+      }
+      return;
+
+    }  // end 'ForEachNearJet(double, double, double, F)'
+
+    // ------------------------------------------------------------------------
+    //! Count how many of a list of ids are in every jet
+    // ------------------------------------------------------------------------
+    /*! Uses the id hash: tally[i] is set to the no. of
+     *  ids in the list that are in jet i (each id in the
+     *  list is counted at most once per jet).
+     */
+    void TallyInJets(const vector<int32_t>& ids, vector<uint32_t>& tally) const {
+
+      tally.assign(GetNJets(), 0);
+      for (const int32_t id : ids) {
+        int32_t lastJet = -1;
+        for (int32_t iFlat = hashHeads[GetBucket(id)]; iFlat >= 0; iFlat = hashNext[iFlat]) {
+          if ((cstIDs[iFlat] != id) || (cstJets[iFlat] == lastJet)) continue;
+          lastJet = cstJets[iFlat];
+          ++tally[lastJet];
+        }
+      }
+      return;
+
+    }  // end 'TallyInJets(vector<int32_t>&, vector<uint32_t>&)'
+
+    // ------------------------------------------------------------------------
+    //! Count how many of a list of ids are in a jet
+    // ------------------------------------------------------------------------
+    /*! Scans the jet's csts for each id if they aren't
+     *  sorted. Otherwise uses the bitsets if the ids are
+     *  dense, and intersects the sorted id lists if not.
+     *  In that case, the ids passed in must be sorted.
+     */
+    size_t CountInJet(const size_t iJet, const vector<int32_t>& ids, const bool isUnique) const {
+
+      if (!isSorted) {
+        size_t count = 0;
+        for (const int32_t id : ids) {
+          for (int32_t iFlat = offsets[iJet]; iFlat < offsets[iJet + 1]; ++iFlat) {
+            if (cstIDs[iFlat] == id) {
+              ++count;
+              break;
+            }
+          }
+        }
+        return count;
+      }
+
+      if (isDense) {
+        const uint64_t* jetBits = bits.data() + (iJet * nWords);
+        const uint64_t  nBits   = nWords * 64;
+
+        size_t count = 0;
+        for (const int32_t id : ids) {
+          const uint64_t iBit = (int64_t) id - minID;
+          if (iBit >= nBits) continue;
+          count += (jetBits[iBit / 64] >> (iBit % 64)) & 1;
+        }
+        return count;
+      }
+      return SCorrelatorResponseMakerIntersect::Count(
+        ids.data(),
+        ids.size(),
+        cstIDs.data() + offsets[iJet],
+        GetNCsts(iJet),
+        isUnique
+      );
+
+    }  // end 'CountInJet(size_t, vector<int32_t>&, bool)'
+
+    // ------------------------------------------------------------------------
+    //! Get delta-r between a reco jet and an eta, phi
+    // ------------------------------------------------------------------------
+    double GetDeltaR(const size_t iJet, const double etaOther, const double phiOther) const {
+      return std::hypot(
+        eta[iJet] - etaOther,
+        std::remainder(phi[iJet] - phiOther, 2. * M_PI)
+      );
+    }  // end 'GetDeltaR(size_t, double, double)'
+
+  };  // end SCorrelatorResponseMakerRecoCache
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
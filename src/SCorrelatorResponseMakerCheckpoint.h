@@ -0,0 +1,146 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerCheckpoint.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Checkpoint sidecar for the 'SCorrelatorResponseMaker'
+ *  module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERCHECKPOINT_H
+#define SCORRELATORRESPONSEMAKERCHECKPOINT_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Checkpoint of a (partially) processed run
+  // --------------------------------------------------------------------------
+  /*! Records where a run got to, along with enough
+   *  information (a hash of the configuration and IDs
+   *  of the input files) to check that a restarted
+   *  job is processing the same thing. Stored as a
+   *  small text file next to the output.
+   */
+  struct SCorrelatorResponseMakerCheckpoint {
+
+    // run identity
+    uint64_t configHash = 0;
+    string   trueInputID;
+    string   recoInputID;
+
+    // progress
+    uint32_t iChunk     = 0;
+    uint64_t chunkFirst = 0;
+    uint64_t nextEntry  = 0;
+
+    // ------------------------------------------------------------------------
+    //! 64-bit FNV-1a hash of a string
+    // ------------------------------------------------------------------------
+    static uint64_t Hash(const string& str) {
+
+      uint64_t hash = 14695981039346656037ULL;
+      for (const char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+
+    }  // end 'Hash(string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get an identifier of an input file
+    // ------------------------------------------------------------------------
+    /*! Uses the file's UUID (unique to each written
+     *  file) and size, which identifies it without
+     *  having to read its full contents.
+     */
+    static string GetFileID(TFile* file) {
+
+      stringstream id;
+      id << file -> GetUUID().AsString() << ":" << file -> GetSize();
+      return id.str();
+
+    }  // end 'GetFileID(TFile*)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Check if another checkpoint is from the same run
+    // ------------------------------------------------------------------------
+    bool IsSameRun(const SCorrelatorResponseMakerCheckpoint& other) const {
+
+      return (
+        (configHash  == other.configHash)  &&
+        (trueInputID == other.trueInputID) &&
+        (recoInputID == other.recoInputID)
+      );
+
+    }  // end 'IsSameRun(SCorrelatorResponseMakerCheckpoint&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Write checkpoint to file
+    // ------------------------------------------------------------------------
+    /*! Written to a temporary file which is then renamed,
+     *  so that a job killed mid-write never leaves a
+     *  truncated checkpoint.
+     */
+    bool Write(const string& fileName) const {
+
+      const string tmpName = fileName + ".tmp";
+      {
+        ofstream out(tmpName);
+        if (!out.good()) return false;
+
+        out << "configHash " << configHash  << "\n"
+            << "trueInput "  << trueInputID << "\n"
+            << "recoInput "  << recoInputID << "\n"
+            << "iChunk "     << iChunk      << "\n"
+            << "chunkFirst " << chunkFirst  << "\n"
+            << "nextEntry "  << nextEntry   << endl;
+        if (!out.good()) return false;
+      }
+      return (rename(tmpName.data(), fileName.data()) == 0);
+
+    }  // end 'Write(string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Read checkpoint from file
+    // ------------------------------------------------------------------------
+    bool Read(const string& fileName) {
+
+      ifstream in(fileName);
+      if (!in.good()) return false;
+
+      string key;
+      while (in >> key) {
+        if      (key == "configHash") in >> configHash;
+        else if (key == "trueInput")  in >> trueInputID;
+        else if (key == "recoInput")  in >> recoInputID;
+        else if (key == "iChunk")     in >> iChunk;
+        else if (key == "chunkFirst") in >> chunkFirst;
+        else if (key == "nextEntry")  in >> nextEntry;
+        else return false;
+      }
+      return true;
+
+    }  // end 'Read(string&)'
+
+  };  // end SCorrelatorResponseMakerCheckpoint
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -34,14 +34,163 @@ namespace SColdQcdCorrelatorAnalysis {
     string inRecoTreeName {""};
     string outFileName    {""};
 
+    // input options
+    //   - n.b. if doDetectInput, each input tree is read as
+    //     legacy or native depending on its branches (else
+    //     isLegacyIO decides); members of native trees can
+    //     be switched on/off by applying inMemberStatus in
+    //     order, e.g. {{"CstInfo.*", false}, {"CstInfo.pt", true}}
+    //     (members needed for matching are always read)
+    //   - n.b. if useStoredCstEne, legacy cst energies are
+    //     taken from the CstEnergy branch; otherwise they're
+    //     computed from pt and eta with the pion mass
+    bool                       doDetectInput   {true};
+    bool                       useStoredCstEne {false};
+    vector<pair<string, bool>> inMemberStatus  {};
+
+    // entry range options
+    //   - n.b. nEntries (0 = all) from firstEntry are
+    //     processed; if nShards > 1, that range is split
+    //     evenly and only shard iShard is processed
+    //   - n.b. nShards must be at least 1 and iShard
+    //     less than nShards
+    uint64_t firstEntry {0};
+    uint64_t nEntries   {0};
+    uint32_t iShard     {0};
+    uint32_t nShards    {1};
+
+    // batching options
+    //   - n.b. if batchSize > 1, that many events are read
+    //     at once and jet acceptance and the jet dr/qt
+    //     windows are checked across all of them before
+    //     matching each (worthwhile when events have few
+    //     jets, e.g. p+p)
+    uint32_t batchSize {1};
+
+    // output options
+    //   - n.b. output rolls over to a new file once either
+    //     size (in bytes) or entries is reached (0 = never)
+    uint64_t outMaxFileSize    {0};
+    uint64_t outMaxEntries     {0};
+    int64_t  outMaxVirtualSize {0};
+    int64_t  outAutoFlush      {-30000000};
+
+    // sparse output options
+    //   - n.b. if doSparseOutput, only the match records
+    //     (entries, jet/cst indices, overlap, dr and qt)
+    //     are written instead of copies of the jets/csts
+    bool doSparseOutput {false};
+
+    // native output options
+    //   - n.b. basket sizes (in bytes) are per member, as
+    //     every member of the native output is split into
+    //     its own branch
+    int32_t outEvtBasketSize {16000};
+    int32_t outBasketSize    {128000};
+
+    // legacy output precision options
+    //   - n.b. kinematic fields listed here by member name
+    //     (e.g. "jetPt", "cstEta") are stored as floats at
+    //     the given precision, the rest as doubles
+    map<string, SCorrelatorResponseMakerPrecision> outPrecisions {};
+
+    // binned output options
+    //   - n.b. if outBins has 2+ pt edges, matched jets are
+    //     written to one tree per truth jet pt (x eta, if
+    //     2+ eta edges) bin, with fakes binned by reco jet
+    //     pt (x eta); jets outside the edges are dropped
+    SCorrelatorResponseMakerBinning outBins {};
+
+    // jet index options
+    //   - n.b. if doJetIndex, each output file gets an
+    //     index of where each truth and matched reco jet
+    //     went, keyed by input entry and jet ID
+    bool doJetIndex {false};
+
+    // in-chain options
+    //   - n.b. when run in a Fun4All chain (i.e. through
+    //     InitRun/process_event/End rather than Init/
+    //     Analyze/End), the jets and csts of each event
+    //     are taken from the node tree, under these nodes,
+    //     instead of from jet tree files
+    string inTrueNodeName {"TrueJetTree"};
+    string inRecoNodeName {"RecoJetTree"};
+
+    // checkpoint options
+    //   - n.b. a checkpoint is written every nEvtsPerCheckpoint
+    //     events (0 = never) to checkpointFileName (defaults to
+    //     output file name + ".ckpt")
+    bool     doResume           {false};
+    uint64_t nEvtsPerCheckpoint {0};
+    string   checkpointFileName {""};
+
+    // instrumentation options
+    //   - n.b. if doMemTracking is on, memory usage is
+    //     sampled at the start and end of the run, and
+    //     every nEvtsPerMemSample events (0 = never) in
+    //     between
+    bool     doStageTimers     {true};
+    bool     doMemTracking     {false};
+    bool     saveStats         {false};
+    uint64_t nEvtsPerMemSample {100};
+
     // matching options
     /* TODO probably need
      *  - toggle cst analysis on/off
-     *  - toggle matching via cst ID vs. dr/qt
      *  - toggle matching via jets dr/qt vs. cst
      *    (ID or dr/qt)
      */
 
+    // matching constraints
+    //   - n.b. if isOneToOne, reco jets/csts already
+    //     matched to a truth jet/cst can't be matched again
+    bool isOneToOne {false};
+
+    // constituent matching options
+    //   - n.b. by default csts are matched by id; if
+    //     doCstMatchByDr, each truth cst is instead matched
+    //     to the nearest available reco cst within the cst
+    //     dr/qt windows, searched with a k-d tree per reco
+    //     jet (or one for the whole event if not
+    //     doCstTreePerJet)
+    bool doCstMatchByDr  {false};
+    bool doCstTreePerJet {true};
+
+    // reco-to-truth matching options
+    //   - n.b. if doRecoMatching, the best truth jet of
+    //     each reco jet is found from the same overlaps
+    //     and reco jets/csts unclaimed by the truth-side
+    //     matching are saved as fakes
+    bool doRecoMatching {false};
+
+    // global matching options
+    //   - n.b. if doGlobalMatching, truth jets are assigned
+    //     to reco jets one-to-one so as to maximize the sum
+    //     over the event of
+    //       fracWeight * fracCstMatch - drWeight * dr
+    //         - qtWeight * |1 - qt|
+    //     over pairs passing the matching windows, instead
+    //     of taking the best reco jet truth jet by truth jet
+    //   - n.b. every pair's benefit is shifted by the same
+    //     amount so that all pairs in the windows count,
+    //     which favours assigning more pairs
+    bool   doGlobalMatching {false};
+    double globalFracWeight {1.};
+    double globalDrWeight   {0.01};
+    double globalQtWeight   {0.01};
+
+    // candidate indexing options
+    //   - n.b. each event, reco candidates are either
+    //     scanned, hashed by cst id, or binned in eta-phi
+    //     depending on the no. of jets and csts; if
+    //     doCalibrateDispatch, the thresholds below are
+    //     replaced by ones measured at Init (unless the
+    //     jet dr window is pi or more, so that the grid
+    //     would be a single cell)
+    bool     doCalibrateDispatch  {false};
+    double   dispatchMaxBruteCsts {16.};
+    uint64_t dispatchMinGridJets  {64};
+
     // matching cuts
     pair<double, double> fracCstMatchRange {0., 1.};
     pair<double, double> jetMatchQtRange   {0., 10.};
@@ -0,0 +1,201 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerDispatch.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Per-event choice of how reco candidates are
+ *  indexed in the 'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERDISPATCH_H
+#define SCORRELATORRESPONSEMAKERDISPATCH_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Chooses an index for the reco candidate cache
+  // --------------------------------------------------------------------------
+  /*! Small events are fastest with a plain scan of
+   *  every reco jet and its csts; events with many
+   *  csts per jet gain from hashing the cst ids; and
+   *  events with many jets gain from binning them in
+   *  eta-phi. Where one path overtakes another
+   *  depends on the machine, so the thresholds can be
+   *  calibrated with a short benchmark on synthetic
+   *  events.
+   */
+  struct SCorrelatorResponseMakerDispatcher {
+
+    // thresholds
+    double   maxBruteCsts = 16.;  // max avg. no. of csts per jet to scan
+    uint64_t minGridJets  = 64;   // min no. of jets to bin in eta-phi
+    bool     isCalibrated = false;
+
+    // ------------------------------------------------------------------------
+    //! Choose index for an event
+    // ------------------------------------------------------------------------
+    SCorrelatorResponseMakerRecoCache::Index Choose(const size_t nJets, const size_t nCsts) const {
+
+      if (nJets >= minGridJets) return SCorrelatorResponseMakerRecoCache::Grid;
+
+      const double avgCsts = (nJets > 0) ? ((double) nCsts / nJets) : 0.;
+      return (avgCsts <= maxBruteCsts) ? SCorrelatorResponseMakerRecoCache::Brute : SCorrelatorResponseMakerRecoCache::Hash;
+
+    }  // end 'Choose(size_t, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get name of an index
+    // ------------------------------------------------------------------------
+    static string GetIndexName(const size_t index) {
+
+      switch (index) {
+        case SCorrelatorResponseMakerRecoCache::Brute: return "Brute";
+        case SCorrelatorResponseMakerRecoCache::Hash:  return "Hash";
+        case SCorrelatorResponseMakerRecoCache::Grid:  return "Grid";
+        default:                                       return "Unknown";
+      }
+
+    }  // end 'GetIndexName(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Calibrate thresholds
+    // ------------------------------------------------------------------------
+    /*! Times each index on synthetic events where every
+     *  jet is matched against every other. The scan is
+     *  kept up to the largest no. of csts per jet where
+     *  it's no slower than the hash, and the grid is
+     *  used from the smallest no. of jets where it's
+     *  faster than the hash (or never, if it doesn't
+     *  win in the range tried).
+     */
+    void Calibrate(const double cellSize) {
+
+      const size_t nJetsForCsts = 8;
+      const size_t nCstsForJets = 16;
+
+      // find where scanning stops paying off
+      maxBruteCsts = 1.;
+      for (size_t nCsts = 1; nCsts <= 256; nCsts *= 2) {
+        const double brute = TimeIndex(SCorrelatorResponseMakerRecoCache::Brute, nJetsForCsts, nCsts, cellSize);
+        const double hash  = TimeIndex(SCorrelatorResponseMakerRecoCache::Hash,  nJetsForCsts, nCsts, cellSize);
+        if (brute > hash) break;
+        maxBruteCsts = nCsts;
+      }
+
+      // and where binning starts to
+      minGridJets = numeric_limits<uint64_t>::max();
+      for (size_t nJets = 2; nJets <= 512; nJets *= 2) {
+        const double grid = TimeIndex(SCorrelatorResponseMakerRecoCache::Grid, nJets, nCstsForJets, cellSize);
+        const double hash = TimeIndex(SCorrelatorResponseMakerRecoCache::Hash, nJets, nCstsForJets, cellSize);
+        if (grid < hash) {
+          minGridJets = nJets;
+          break;
+        }
+      }
+      isCalibrated = true;
+      return;
+
+    }  // end 'Calibrate(double)'
+
+    private:
+
+      // synthetic jets and csts for calibration
+      struct CalibJet {
+        double pt  = 0.;
+        double eta = 0.;
+        double phi = 0.;
+        double GetPT()  const {return pt;}
+        double GetEta() const {return eta;}
+        double GetPhi() const {return phi;}
+      };
+
+      struct CalibCst {
+        int32_t id = -1;
+        int32_t GetCstID() const {return id;}
+      };
+
+      // ----------------------------------------------------------------------
+      //! Time building and querying one index on a synthetic event
+      // ----------------------------------------------------------------------
+      /*! Returns the fastest of a few repetitions, in
+       *  seconds.
+       */
+      static double TimeIndex(
+        const SCorrelatorResponseMakerRecoCache::Index index,
+        const size_t nJets,
+        const size_t nCstsPerJet,
+        const double cellSize
+      ) {
+
+        const size_t nReps = 16;
+
+        // generate event
+        //   - n.b. ids are shuffled so that sorting isn't free
+        mt19937                          rng(nJets * 1000 + nCstsPerJet);
+        uniform_real_distribution<double> etaDist(-1.1, 1.1);
+        uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+
+        vector<int32_t> ids(nJets * nCstsPerJet);
+        iota(ids.begin(), ids.end(), 0);
+        shuffle(ids.begin(), ids.end(), rng);
+
+        vector<CalibJet>         jets(nJets);
+        vector<vector<CalibCst>> csts(nJets, vector<CalibCst>(nCstsPerJet));
+        vector<vector<int32_t>>  queries(nJets);
+        for (size_t iJet = 0; iJet < nJets; ++iJet) {
+          jets[iJet] = {10., etaDist(rng), phiDist(rng)};
+          for (size_t iCst = 0; iCst < nCstsPerJet; ++iCst) {
+            csts[iJet][iCst].id = ids[(iJet * nCstsPerJet) + iCst];
+            queries[iJet].push_back(csts[iJet][iCst].id);
+          }
+          sort(queries[iJet].begin(), queries[iJet].end());
+        }
+
+        // and time building + querying
+        SCorrelatorResponseMakerRecoCache cache;
+        vector<uint32_t>                  tally;
+        size_t                            sum  = 0;
+        double                            best = numeric_limits<double>::max();
+        for (size_t iRep = 0; iRep < nReps; ++iRep) {
+          const auto start = chrono::steady_clock::now();
+          cache.Build(
+            jets,
+            csts,
+            [](const CalibJet&) {return true;},
+            [](const CalibCst&) {return true;},
+            index,
+            cellSize
+          );
+          for (size_t iJet = 0; iJet < nJets; ++iJet) {
+            if (index == SCorrelatorResponseMakerRecoCache::Hash) {
+              cache.TallyInJets(queries[iJet], tally);
+            }
+            cache.ForEachNearJet(jets[iJet].eta, jets[iJet].phi, cellSize, [&](const size_t iReco) {
+              if (cache.GetDeltaR(iReco, jets[iJet].eta, jets[iJet].phi) > cellSize) return;
+              sum += (index == SCorrelatorResponseMakerRecoCache::Hash) ? tally[iReco] : cache.CountInJet(iReco, queries[iJet], true);
+            });
+          }
+          const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+          best = min(best, elapsed.count());
+        }
+
+        // keep queries from being optimized away
+        volatile size_t sink = sum;
+        (void) sink;
+        return best;
+
+      }  // end 'TimeIndex(Index, size_t, size_t, double)'
+
+  };  // end SCorrelatorResponseMakerDispatcher
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
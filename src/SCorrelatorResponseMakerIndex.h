@@ -0,0 +1,313 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerIndex.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Jet lookup index of the output of the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERINDEX_H
+#define SCORRELATORRESPONSEMAKERINDEX_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Where a jet of an input event went in the output
+  // --------------------------------------------------------------------------
+  /*! outBin is the bin tree the jet went to (-1 for the
+   *  main tree), outEntry the entry of that tree, and
+   *  outJet the position of the jet within the entry.
+   *  Rows are ordered by (inEntry, jetID), and rows of
+   *  the same jet by where they went.
+   */
+  struct SCorrelatorResponseMakerIndexRow {
+
+    uint64_t inEntry  = 0;
+    uint32_t jetID    = 0;
+    int32_t  outBin   = -1;
+    int64_t  outEntry = -1;
+    uint32_t outJet   = 0;
+
+    bool operator<(const SCorrelatorResponseMakerIndexRow& rhs) const {
+      return tie(inEntry, jetID, outBin, outEntry, outJet) < tie(rhs.inEntry, rhs.jetID, rhs.outBin, rhs.outEntry, rhs.outJet);
+    }
+
+  };  // end SCorrelatorResponseMakerIndexRow
+
+
+
+  // --------------------------------------------------------------------------
+  //! Index of jets of one side (truth or reco) in output
+  // --------------------------------------------------------------------------
+  /*! Rows are collected as the output is filled, and
+   *  written as a tree sorted by (input entry, jet ID)
+   *  along with a TTreeIndex on the same keys, so the
+   *  row of a given jet can be found in O(log n) with
+   *  GetEntryWithIndex() (or by bisecting the entries).
+   *  A key needn't be unique: if matching isn't one-to-
+   *  one, a reco jet matched by several truth jets gets
+   *  a row for each, and these are adjacent.
+   *
+   *  Until then, rows can be staged (e.g. at every
+   *  checkpoint): only rows added since the last stage
+   *  are appended to an unsorted staging tree, which is
+   *  dropped once the sorted index is written. When
+   *  resuming, the staging tree is read back and kept
+   *  appending to. The
+   *  staging tree points at stagedRow, so the index
+   *  must stay put while it's in use.
+   */
+  struct SCorrelatorResponseMakerJetIndex {
+
+    // name of index tree
+    string name = "ResponseTrueJetIndex";
+
+    // rows of current output file
+    vector<SCorrelatorResponseMakerIndexRow> rows;
+
+    // staging tree of current output file
+    TTree*                           staged  = NULL;
+    size_t                           nStaged = 0;
+    SCorrelatorResponseMakerIndexRow stagedRow;
+
+    // ------------------------------------------------------------------------
+    //! Reset rows
+    // ------------------------------------------------------------------------
+    /*! Doesn't touch the staging tree, which is owned
+     *  by its file.
+     */
+    void Reset() {
+      rows.clear();
+      staged  = NULL;
+      nStaged = 0;
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Get name of staging tree
+    // ------------------------------------------------------------------------
+    string GetStagedName() const {
+      return name + "_staged";
+    }  // end 'GetStagedName()'
+
+    // ------------------------------------------------------------------------
+    //! Add a jet
+    // ------------------------------------------------------------------------
+    void Add(
+      const uint64_t inEntry,
+      const uint32_t jetID,
+      const int32_t outBin,
+      const int64_t outEntry,
+      const uint32_t outJet
+    ) {
+      rows.push_back( {inEntry, jetID, outBin, outEntry, outJet} );
+      return;
+    }  // end 'Add(uint64_t, uint32_t, int32_t, int64_t, uint32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Append rows added since last stage to staging tree
+    // ------------------------------------------------------------------------
+    /*! The staging tree is auto-saved, so the rows staged
+     *  so far are on disk once the file is synced.
+     */
+    void Stage(TFile* file) {
+
+      if (!staged) {
+        file -> cd();
+        staged = new TTree(GetStagedName().data(), "Unsorted rows of index of jets in response trees");
+        BranchRow(staged, stagedRow);
+      }
+
+      for (size_t iRow = nStaged; iRow < rows.size(); ++iRow) {
+        stagedRow = rows[iRow];
+        staged -> Fill();
+      }
+      nStaged = rows.size();
+      staged -> AutoSave("SaveSelf");
+      return;
+
+    }  // end 'Stage(TFile*)'
+
+    // ------------------------------------------------------------------------
+    //! Sort rows and write them to a file
+    // ------------------------------------------------------------------------
+    /*! Meant to be called once per file, when it's
+     *  closed. Drops the staging tree (if any) from the
+     *  file afterwards.
+     */
+    void Write(TFile* file) {
+
+      file -> cd();
+      sort(rows.begin(), rows.end());
+
+      SCorrelatorResponseMakerIndexRow row;
+      TTree* tree = new TTree(name.data(), "Index of jets in response trees");
+      BranchRow(tree, row);
+      for (const SCorrelatorResponseMakerIndexRow& sorted : rows) {
+        row = sorted;
+        tree -> Fill();
+      }
+      tree -> BuildIndex("InEntry", "JetID");
+      tree -> Write();
+      delete tree;
+
+      // staged rows are no longer needed
+      //   - n.b. this deletes the staging tree too
+      if (staged) {
+        staged -> Delete("all");
+        staged = NULL;
+      }
+      nStaged = 0;
+      return;
+
+    }  // end 'Write(TFile*)'
+
+    // ------------------------------------------------------------------------
+    //! Read staged rows back from a file (e.g. when resuming)
+    // ------------------------------------------------------------------------
+    /*! Every staged row must be from an input entry before
+     *  nextEntry (i.e. from before the point resumed
+     *  from); returns false otherwise, or if there's no
+     *  staging tree. The staging tree is kept, and later
+     *  rows are appended to it, until Write() is called,
+     *  so the rows stay on disk if the job stops again.
+     */
+    bool Read(TFile* file, const uint64_t nextEntry) {
+
+      Reset();
+
+      TTree* tree = NULL;
+      file -> GetObject(GetStagedName().data(), tree);
+      if (!tree) return false;
+
+      SetRowAddresses(tree, stagedRow);
+      for (int64_t iRow = 0; iRow < tree -> GetEntries(); ++iRow) {
+        tree -> GetEntry(iRow);
+        if (stagedRow.inEntry >= nextEntry) {
+          tree -> ResetBranchAddresses();
+          rows.clear();
+          return false;
+        }
+        rows.push_back(stagedRow);
+      }
+      staged  = tree;
+      nStaged = rows.size();
+      return true;
+
+    }  // end 'Read(TFile*, uint64_t)'
+
+    // ------------------------------------------------------------------------
+    //! Look up a jet in an index tree of a file
+    // ------------------------------------------------------------------------
+    /*! Returns false if there's no such index or the jet
+     *  isn't in it. If the jet has several rows, one of
+     *  them is returned (see FindAll()).
+     */
+    static bool Find(
+      TFile* file,
+      const string& name,
+      const uint64_t inEntry,
+      const uint32_t jetID,
+      SCorrelatorResponseMakerIndexRow& row
+    ) {
+
+      TTree* tree = NULL;
+      file -> GetObject(name.data(), tree);
+      if (!tree) return false;
+
+      SetRowAddresses(tree, row);
+      const bool isFound = (tree -> GetEntryWithIndex(inEntry, jetID) > 0);
+      tree -> ResetBranchAddresses();
+      return isFound;
+
+    }  // end 'Find(TFile*, string&, uint64_t, uint32_t, SCorrelatorResponseMakerIndexRow&)'
+
+    // ------------------------------------------------------------------------
+    //! Look up every row of a jet in an index tree of a file
+    // ------------------------------------------------------------------------
+    /*! For keys which aren't unique (e.g. reco jets when
+     *  matching isn't one-to-one). Rows are returned in
+     *  order. Returns false if there's no such index or
+     *  the jet isn't in it.
+     */
+    static bool FindAll(
+      TFile* file,
+      const string& name,
+      const uint64_t inEntry,
+      const uint32_t jetID,
+      vector<SCorrelatorResponseMakerIndexRow>& found
+    ) {
+
+      found.clear();
+
+      TTree* tree = NULL;
+      file -> GetObject(name.data(), tree);
+      if (!tree) return false;
+
+      // find any row of the jet, then walk back to the
+      // first and forward to the last
+      //   - n.b. rows are sorted by key, so the rows of a
+      //     jet are adjacent
+      const int64_t iAny = tree -> GetEntryNumberWithIndex(inEntry, jetID);
+      if (iAny < 0) return false;
+
+      SCorrelatorResponseMakerIndexRow row;
+      SetRowAddresses(tree, row);
+      const auto isJet = [&]() {return (row.inEntry == inEntry) && (row.jetID == jetID);};
+
+      int64_t iFirst = iAny;
+      while (iFirst > 0) {
+        tree -> GetEntry(iFirst - 1);
+        if (!isJet()) break;
+        --iFirst;
+      }
+      for (int64_t iRow = iFirst; iRow < tree -> GetEntries(); ++iRow) {
+        tree -> GetEntry(iRow);
+        if (!isJet()) break;
+        found.push_back(row);
+      }
+      tree -> ResetBranchAddresses();
+      return !found.empty();
+
+    }  // end 'FindAll(TFile*, string&, uint64_t, uint32_t, vector<SCorrelatorResponseMakerIndexRow>&)'
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Create branches of an index tree for a row
+      // ----------------------------------------------------------------------
+      static void BranchRow(TTree* tree, SCorrelatorResponseMakerIndexRow& row) {
+        tree -> Branch("InEntry",  &row.inEntry,  "InEntry/l");
+        tree -> Branch("JetID",    &row.jetID,    "JetID/i");
+        tree -> Branch("OutBin",   &row.outBin,   "OutBin/I");
+        tree -> Branch("OutEntry", &row.outEntry, "OutEntry/L");
+        tree -> Branch("OutJet",   &row.outJet,   "OutJet/i");
+        return;
+      }  // end 'BranchRow(TTree*, SCorrelatorResponseMakerIndexRow&)'
+
+      // ----------------------------------------------------------------------
+      //! Set addresses of an index tree to a row
+      // ----------------------------------------------------------------------
+      static void SetRowAddresses(TTree* tree, SCorrelatorResponseMakerIndexRow& row) {
+        tree -> SetBranchAddress("InEntry",  &row.inEntry);
+        tree -> SetBranchAddress("JetID",    &row.jetID);
+        tree -> SetBranchAddress("OutBin",   &row.outBin);
+        tree -> SetBranchAddress("OutEntry", &row.outEntry);
+        tree -> SetBranchAddress("OutJet",   &row.outJet);
+        return;
+      }  // end 'SetRowAddresses(TTree*, SCorrelatorResponseMakerIndexRow&)'
+
+  };  // end SCorrelatorResponseMakerJetIndex
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
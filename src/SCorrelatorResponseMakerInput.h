@@ -26,27 +26,32 @@ namespace SColdQcdCorrelatorAnalysis {
     Types::REvtInfo evt;
 
     // jet and constituent info
-    vector<Types::JetInfo>         jets;
-    vector<vector<Types::CstInfo>> csts; 
+    //   - n.b. these are allocated from the
+    //     per-event arena (if provided)
+    pmr::vector<Types::JetInfo>              jets;
+    pmr::vector<pmr::vector<Types::CstInfo>> csts; 
+
+    // ------------------------------------------------------------------------
+    //! ctor accepting memory resource to allocate from
+    // ------------------------------------------------------------------------
+    SCorrelatorResponseMakerRecoInput(pmr::memory_resource* resource = pmr::get_default_resource()) :
+      jets(resource),
+      csts(resource)
+    {}
 
     // ------------------------------------------------------------------------
     //! Reset addresses
     // ------------------------------------------------------------------------
+    /*! Swaps containers with empty ones so that no
+     *  memory from the arena is held onto.
+     */
     void Reset() {
       evt.Reset();
-      jets.clear();
-      csts.clear();
+      pmr::vector<Types::JetInfo>(jets.get_allocator()).swap(jets);
+      pmr::vector<pmr::vector<Types::CstInfo>>(csts.get_allocator()).swap(csts);
       return;
     }  // end 'Reset()'
 
-    // -----------------------------------------------------------------------
-    //! Set addresses on a TTree
-    // ------------------------------------------------------------------------
-    void SetTreeAddresses(TTree* tree) {
-      /* TODO fill in */
-      return;
-    }  // end 'SetTreeAddresses(TTree*)'
-
   };  // end SCorrelatorResponseMakerRecoInput
 
 
@@ -60,28 +65,319 @@ namespace SColdQcdCorrelatorAnalysis {
     Types::GEvtInfo evt;
 
     // jet and constituent info
-    vector<Types::JetInfo>         jets;
-    vector<vector<Types::CstInfo>> csts; 
+    //   - n.b. these are allocated from the
+    //     per-event arena (if provided)
+    pmr::vector<Types::JetInfo>              jets;
+    pmr::vector<pmr::vector<Types::CstInfo>> csts; 
+
+    // ------------------------------------------------------------------------
+    //! ctor accepting memory resource to allocate from
+    // ------------------------------------------------------------------------
+    SCorrelatorResponseMakerTruthInput(pmr::memory_resource* resource = pmr::get_default_resource()) :
+      jets(resource),
+      csts(resource)
+    {}
 
     // ------------------------------------------------------------------------
     //! Reset addresses
     // ------------------------------------------------------------------------
+    /*! Swaps containers with empty ones so that no
+     *  memory from the arena is held onto.
+     */
     void Reset() {
       evt.Reset();
-      jets.clear();
-      csts.clear();
+      pmr::vector<Types::JetInfo>(jets.get_allocator()).swap(jets);
+      pmr::vector<pmr::vector<Types::CstInfo>>(csts.get_allocator()).swap(csts);
       return;
     }  // end 'Reset()'
 
-    // -----------------------------------------------------------------------
+  };  // end SCorrelatorResponseMakerTruthInput
+
+
+
+  // --------------------------------------------------------------------------
+  //! Native jet tree input
+  // --------------------------------------------------------------------------
+  /*! Reads the event, jet and cst objects directly from
+   *  fully split branches, i.e.
+   *    - "EvtInfo."    (Types::REvtInfo or GEvtInfo),
+   *    - "JetInfo."    (vector<Types::JetInfo>),
+   *    - "CstInfo."    (vector<Types::CstInfo>), and
+   *    - "CstOffsets"  (vector<uint32_t>),
+   *  where the csts of all jets are stored flat, with
+   *  those of jet i at [CstOffsets[i], CstOffsets[i + 1]).
+   *  Since every data member is its own sub-branch (e.g.
+   *  "CstInfo.pt"), members which aren't needed can be
+   *  switched off and are left default-constructed.
+   *
+   *  When running in a Fun4All chain, the same objects
+   *  are instead picked up from data nodes of the same
+   *  names (less the trailing dot) under one composite
+   *  node per input.
+   *
+   *  n.b. the branch buffers are kept here rather than
+   *  in the input containers, as those get swapped in
+   *  and out of batches.
+   */
+  template <typename TEvt, typename TInput> struct SCorrelatorResponseMakerNativeInput {
+
+    // branch buffers
+    TEvt*                   evt        = NULL;
+    vector<Types::JetInfo>* jets       = NULL;
+    vector<Types::CstInfo>* csts       = NULL;
+    vector<uint32_t>*       cstOffsets = NULL;
+
+    // ------------------------------------------------------------------------
+    //! Check if a tree is in the native format
+    // ------------------------------------------------------------------------
+    static bool IsNative(TTree* tree) {
+      return (tree -> GetBranch("JetInfo.") != NULL);
+    }  // end 'IsNative(TTree*)'
+
+    // ------------------------------------------------------------------------
+    //! Get branches the matching can't do without
+    // ------------------------------------------------------------------------
+    static const vector<string>& GetRequiredBranches() {
+
+      static const vector<string> required = {
+        "JetInfo.jetID",
+        "JetInfo.pt",
+        "JetInfo.eta",
+        "JetInfo.phi",
+        "CstInfo.cstID",
+        "CstInfo.pt",
+        "CstInfo.eta",
+        "CstInfo.phi",
+        "CstOffsets"
+      };
+      return required;
+
+    }  // end 'GetRequiredBranches()'
+
+    // ------------------------------------------------------------------------
     //! Set addresses on a TTree
     // ------------------------------------------------------------------------
-    void SetTreeAddresses(TTree* tree) {
-      /* TODO fill in */
+    /*! Member statuses are applied in order after the
+     *  addresses are set, so later patterns override
+     *  earlier ones, e.g. {"CstInfo.*", false} followed
+     *  by {"CstInfo.pt", true}. Members needed for the
+     *  matching (see 'GetRequiredBranches()') are always
+     *  read, with a warning if a pattern switched them
+     *  off.
+     */
+    void SetTreeAddresses(TTree* tree, const vector<pair<string, bool>>& memberStatus = {}) {
+
+      tree -> SetBranchAddress("EvtInfo.",   &evt);
+      tree -> SetBranchAddress("JetInfo.",   &jets);
+      tree -> SetBranchAddress("CstInfo.",   &csts);
+      tree -> SetBranchAddress("CstOffsets", &cstOffsets);
+      for (const auto& [pattern, status] : memberStatus) {
+        tree -> SetBranchStatus(pattern.data(), status);
+      }
+
+      // and switch required members back on
+      for (const string& branch : GetRequiredBranches()) {
+        if (!tree -> GetBranchStatus(branch.data())) {
+          cerr << "WARNING: " << branch << " is needed for matching and can't be switched off! Reading it anyway." << endl;
+          tree -> SetBranchStatus(branch.data(), true);
+        }
+      }
       return;
-    }  // end 'SetTreeAddresses(TTree*)'
 
-  };  // end SCorrelatorResponseMakerTruthInput
+    }  // end 'SetTreeAddresses(TTree*, vector<pair<string, bool>>&)'
+
+    // ------------------------------------------------------------------------
+    //! Set addresses to objects on the node tree
+    // ------------------------------------------------------------------------
+    /*! Returns false if the composite node or any of the
+     *  objects under it is missing. 'getClass' only finds
+     *  an object held by a PHDataNode of exactly its type
+     *  (a PHIODataNode of that type works too), so the
+     *  nodes must be:
+     *    - EvtInfo:    PHDataNode<TEvt>
+     *    - JetInfo:    PHDataNode<vector<Types::JetInfo>>
+     *    - CstInfo:    PHDataNode<vector<Types::CstInfo>>
+     *    - CstOffsets: PHDataNode<vector<uint32_t>>
+     *  A vector wrapped in some other object won't be
+     *  found.
+     */
+    bool SetNodeAddresses(PHCompositeNode* topNode, const string& nodeName) {
+
+      PHNodeIterator   iter(topNode);
+      PHCompositeNode* node = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", nodeName));
+      if (!node) return false;
+
+      evt        = findNode::getClass<TEvt>(node, "EvtInfo");
+      jets       = findNode::getClass<vector<Types::JetInfo>>(node, "JetInfo");
+      csts       = findNode::getClass<vector<Types::CstInfo>>(node, "CstInfo");
+      cstOffsets = findNode::getClass<vector<uint32_t>>(node, "CstOffsets");
+      return (evt && jets && csts && cstOffsets);
+
+    }  // end 'SetNodeAddresses(PHCompositeNode*, string&)'
+
+    // ------------------------------------------------------------------------
+    //! Check that buffers are consistent
+    // ------------------------------------------------------------------------
+    /*! Unless there are no jets, there must be one offset
+     *  per jet plus one, non-decreasing, and not past the
+     *  end of the csts.
+     */
+    bool IsValid() const {
+
+      if (!jets) return false;
+      if (jets -> empty()) return true;
+      if (!csts || !cstOffsets) return false;
+      if (cstOffsets -> size() != (jets -> size() + 1)) return false;
+      if (!is_sorted(cstOffsets -> begin(), cstOffsets -> end())) return false;
+      return (cstOffsets -> back() <= csts -> size());
+
+    }  // end 'IsValid()'
+
+    // ------------------------------------------------------------------------
+    //! Copy branch buffers into input
+    // ------------------------------------------------------------------------
+    /*! Returns false (leaving the input empty) if the
+     *  buffers aren't consistent, e.g. if an entry is
+     *  malformed or truncated. The event is left default
+     *  if it wasn't read (e.g. switched off).
+     */
+    bool SetInput(TInput& input) const {
+
+      // make sure container is empty
+      input.Reset();
+      if (!IsValid()) return false;
+
+      // copy event and jets as is
+      if (evt) {
+        input.evt = *evt;
+      }
+      input.jets.assign(jets -> begin(), jets -> end());
+
+      // and split csts by jet
+      const size_t nJets = jets -> size();
+      input.csts.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+        input.csts[iJet].assign(
+          csts -> begin() + (*cstOffsets)[iJet],
+          csts -> begin() + (*cstOffsets)[iJet + 1]
+        );
+      }
+      return true;
+
+    }  // end 'SetInput(TInput&)'
+
+  };  // end SCorrelatorResponseMakerNativeInput
+
+  // native input of each type
+  typedef SCorrelatorResponseMakerNativeInput<Types::REvtInfo, SCorrelatorResponseMakerRecoInput>  SCorrelatorResponseMakerNativeRecoInput;
+  typedef SCorrelatorResponseMakerNativeInput<Types::GEvtInfo, SCorrelatorResponseMakerTruthInput> SCorrelatorResponseMakerNativeTruthInput;
+
+
+
+  // --------------------------------------------------------------------------
+  //! Flattened cst kinematics of a legacy event
+  // --------------------------------------------------------------------------
+  /*! Scratch columns used when translating legacy
+   *  inputs, so that cst energies can be computed for
+   *  every cst in the event in one vectorizable loop
+   *  rather than one four-vector at a time.
+   */
+  struct SCorrelatorResponseMakerLegacyCstColumns {
+
+    vector<double> pt;
+    vector<double> eta;
+    vector<double> ene;
+
+    // ------------------------------------------------------------------------
+    //! Flatten cst pt and eta of all jets
+    // ------------------------------------------------------------------------
+    /*! Takes as many csts from each jet as there are in
+     *  the translated csts, so that the energies line up
+     *  with them in 'SetEnergies()'. The pt and eta columns
+     *  must have at least that many.
+     */
+    void Flatten(
+      const vector<vector<double>>& cstPt,
+      const vector<vector<double>>& cstEta,
+      const pmr::vector<pmr::vector<Types::CstInfo>>& csts
+    ) {
+
+      pt.clear();
+      eta.clear();
+      for (size_t iJet = 0; iJet < csts.size(); ++iJet) {
+        const size_t nCsts = csts[iJet].size();
+        pt.insert(pt.end(), cstPt[iJet].begin(), cstPt[iJet].begin() + nCsts);
+        eta.insert(eta.end(), cstEta[iJet].begin(), cstEta[iJet].begin() + nCsts);
+      }
+      return;
+
+    }  // end 'Flatten(vector<vector<double>>&, vector<vector<double>>&, pmr::vector<pmr::vector<Types::CstInfo>>&)'
+
+    // ------------------------------------------------------------------------
+    //! Compute energies for a given mass
+    // ------------------------------------------------------------------------
+    /*! E = sqrt(pt^2 cosh^2(eta) + m^2), with cosh
+     *  written in terms of exp so that a vector exp can
+     *  be used where the math library provides one.
+     */
+    void CalcEnergies(const double mass) {
+
+      const size_t  nCsts  = pt.size();
+      const double  mass2  = mass * mass;
+      const double* cstPt  = pt.data();
+      const double* cstEta = eta.data();
+      ene.resize(nCsts);
+
+      double* cstEne = ene.data();
+      #pragma omp simd
+      for (size_t iCst = 0; iCst < nCsts; ++iCst) {
+        const double expEta = exp(cstEta[iCst]);
+        const double cstP   = 0.5 * cstPt[iCst] * (expEta + (1. / expEta));
+        cstEne[iCst] = sqrt((cstP * cstP) + mass2);
+      }
+      return;
+
+    }  // end 'CalcEnergies(double)'
+
+    // ------------------------------------------------------------------------
+    //! Set computed energies on csts
+    // ------------------------------------------------------------------------
+    void SetEnergies(pmr::vector<pmr::vector<Types::CstInfo>>& csts) const {
+
+      size_t iFlat = 0;
+      for (pmr::vector<Types::CstInfo>& jetCsts : csts) {
+        for (Types::CstInfo& cst : jetCsts) {
+          cst.SetEne( ene[iFlat++] );
+        }
+      }
+      return;
+
+    }  // end 'SetEnergies(pmr::vector<pmr::vector<Types::CstInfo>>&)'
+
+    // ------------------------------------------------------------------------
+    //! Check that a jet column has one element per jet
+    // ------------------------------------------------------------------------
+    template <typename T> static bool IsJetColumn(const vector<T>* column, const size_t nJets) {
+      return column && (column -> size() == nJets);
+    }  // end 'IsJetColumn(vector<T>*, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Check that a cst column has the same shape as another
+    // ------------------------------------------------------------------------
+    /*! i.e. one vector per jet, each with as many csts as
+     *  the corresponding vector of the reference column.
+     */
+    template <typename T> static bool IsCstColumn(const vector<vector<T>>* column, const vector<vector<double>>& reference) {
+
+      if (!IsJetColumn(column, reference.size())) return false;
+      for (size_t iJet = 0; iJet < reference.size(); ++iJet) {
+        if ((*column)[iJet].size() != reference[iJet].size()) return false;
+      }
+      return true;
+
+    }  // end 'IsCstColumn(vector<vector<T>>*, vector<vector<double>>&)'
+
+  };  // end SCorrelatorResponseMakerLegacyCstColumns
 
 
 
@@ -116,6 +412,9 @@ namespace SColdQcdCorrelatorAnalysis {
     vector<vector<double>>* cstEta     = NULL;
     vector<vector<double>>* cstPhi     = NULL;
 
+    // scratch columns for translation
+    SCorrelatorResponseMakerLegacyCstColumns columns;
+
 
 
     // ------------------------------------------------------------------------
@@ -183,13 +482,55 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
+    // ------------------------------------------------------------------------
+    //! Check that branches are consistent
+    // ------------------------------------------------------------------------
+    /*! Every jet column must have one element per jet,
+     *  and every cst column (the stored energies only if
+     *  used) as many csts per jet as CstZ.
+     */
+    bool IsValid(const bool useStoredEne) const {
+
+      if (!jetNumCst || !cstZ) return false;
+
+      const size_t nJets = jetNumCst -> size();
+      const bool   isJetGood = (
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetID, nJets)     &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetEnergy, nJets) &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetPt, nJets)     &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetEta, nJets)    &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetPhi, nJets)    &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetArea, nJets)   &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(cstZ, nJets)
+      );
+      const bool isCstGood = (
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstType, *cstZ)    &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstMatchID, *cstZ) &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstDr, *cstZ)      &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstPt, *cstZ)      &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstEta, *cstZ)     &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstPhi, *cstZ)     &&
+        (!useStoredEne || SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstEnergy, *cstZ))
+      );
+      return (isJetGood && isCstGood);
+
+    }  // end 'IsValid(bool)'
+
+
+
     // ------------------------------------------------------------------------
     //! Translate legacy reco input into normal reco input
     // ------------------------------------------------------------------------
-    void SetInput(SCorrelatorResponseMakerRecoInput& input) {
+    /*! Cst energies are either taken from the stored
+     *  branch (if useStoredEne) or computed from pt and
+     *  eta assuming the pion mass. Returns false (leaving
+     *  the input empty) if the branches aren't consistent.
+     */
+    bool SetInput(SCorrelatorResponseMakerRecoInput& input, const bool useStoredEne = false) {
 
       // make sure container is empty
       input.Reset();
+      if (!IsValid(useStoredEne)) return false;
 
       // set event-level variables
       input.evt.SetNTrks( evtNumTrks );
@@ -202,46 +543,57 @@ namespace SColdQcdCorrelatorAnalysis {
       input.evt.SetVR( hypot(evtVtxX, evtVtxY) );
 
       // set jet variables
-      input.jets.resize( jetNumCst -> size() );
-      for (size_t iJet = 0; iJet < jetNumCst -> size(); iJet++) {
-        input.jets.at(iJet).SetJetID( jetID -> at(iJet) );
-        input.jets.at(iJet).SetNCsts( jetNumCst -> at(iJet) );
-        input.jets.at(iJet).SetEne( jetEnergy -> at(iJet) );
-        input.jets.at(iJet).SetPT( jetPt -> at(iJet) );
-        input.jets.at(iJet).SetEta( jetEta -> at(iJet) );
-        input.jets.at(iJet).SetPhi( jetPhi -> at(iJet) );
-        input.jets.at(iJet).SetArea( jetArea -> at(iJet) );
+      const size_t nJets = jetNumCst -> size();
+      input.jets.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+        input.jets[iJet].SetJetID( (*jetID)[iJet] );
+        input.jets[iJet].SetNCsts( (*jetNumCst)[iJet] );
+        input.jets[iJet].SetEne( (*jetEnergy)[iJet] );
+        input.jets[iJet].SetPT( (*jetPt)[iJet] );
+        input.jets[iJet].SetEta( (*jetEta)[iJet] );
+        input.jets[iJet].SetPhi( (*jetPhi)[iJet] );
+        input.jets[iJet].SetArea( (*jetArea)[iJet] );
       }  // end jet loop
 
-      // set cst variables
-      input.csts.resize( jetNumCst -> size() );
-      for (size_t iJet = 0; iJet < jetNumCst -> size(); iJet++) {
-
-        // loop over constituents
-        input.csts.at(iJet).resize( (cstZ -> at(iJet)).size() );
-        for (size_t iCst = 0; iCst < (cstZ -> at(iJet)).size(); iCst++) {
-          input.csts.at(iJet).at(iCst).SetType( (cstType -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetJetID( jetID -> at(iJet) );
-          input.csts.at(iJet).at(iCst).SetCstID( (cstMatchID -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetZ( (cstZ -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetDR( (cstDr -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetPT( (cstPt -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetEta( (cstEta -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetPhi( (cstPhi -> at(iJet)).at(iCst) );
-
-          // set cst. energy
-          ROOT::Math::PtEtaPhiMVector pCst(
-            input.csts.at(iJet).at(iCst).GetPT(),
-            input.csts.at(iJet).at(iCst).GetEta(),
-            input.csts.at(iJet).at(iCst).GetPhi(),
-            Const::MassPion()
-          );
-          input.csts.at(iJet).at(iCst).SetEne( pCst.E() );
-        }  // end cst loop
+      // set cst variables column by column
+      input.csts.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+
+        const size_t nCsts = (*cstZ)[iJet].size();
+        input.csts[iJet].resize(nCsts);
+
+        Types::CstInfo*       csts  = input.csts[iJet].data();
+        const unsigned int    id    = (*jetID)[iJet];
+        const vector<int>&    type  = (*cstType)[iJet];
+        const vector<int>&    match = (*cstMatchID)[iJet];
+        const vector<double>& z     = (*cstZ)[iJet];
+        const vector<double>& dr    = (*cstDr)[iJet];
+        const vector<double>& pt    = (*cstPt)[iJet];
+        const vector<double>& eta   = (*cstEta)[iJet];
+        const vector<double>& phi   = (*cstPhi)[iJet];
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetType( type[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetJetID( id );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetCstID( match[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetZ( z[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetDR( dr[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetPT( pt[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetEta( eta[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetPhi( phi[iCst] );
+        if (useStoredEne) {
+          const vector<double>& ene = (*cstEnergy)[iJet];
+          for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetEne( ene[iCst] );
+        }
       }  // end jet loop
-      return;
 
-    }  // end 'SetInput(SCorrelatorResponseMakerRecoInput&)'
+      // if needed, compute cst energies for whole event
+      if (!useStoredEne) {
+        columns.Flatten(*cstPt, *cstEta, input.csts);
+        columns.CalcEnergies( Const::MassPion() );
+        columns.SetEnergies(input.csts);
+      }
+      return true;
+
+    }  // end 'SetInput(SCorrelatorResponseMakerRecoInput&, bool)'
 
   };  // end SCorrelatorResponseMakerLegacyRecoInput
 
@@ -282,6 +634,9 @@ namespace SColdQcdCorrelatorAnalysis {
     vector<vector<double>>* cstEta     = NULL;
     vector<vector<double>>* cstPhi     = NULL;
 
+    // scratch columns for translation
+    SCorrelatorResponseMakerLegacyCstColumns columns;
+
 
 
     // ------------------------------------------------------------------------
@@ -360,13 +715,59 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
+    // ------------------------------------------------------------------------
+    //! Check that branches are consistent
+    // ------------------------------------------------------------------------
+    /*! Every jet column must have one element per jet,
+     *  and every cst column (the stored energies only if
+     *  used) as many csts per jet as CstZ.
+     */
+    bool IsValid(const bool useStoredEne) const {
+
+      if (!jetNumCst || !cstZ) return false;
+
+      const size_t nJets = jetNumCst -> size();
+      const bool   isJetGood = (
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetID, nJets)     &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetEnergy, nJets) &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetPt, nJets)     &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetEta, nJets)    &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetPhi, nJets)    &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(jetArea, nJets)   &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsJetColumn(cstZ, nJets)
+      );
+      const bool isCstGood = (
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstID, *cstZ)      &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstEmbedID, *cstZ) &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstDr, *cstZ)      &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstPt, *cstZ)      &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstEta, *cstZ)     &&
+        SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstPhi, *cstZ)     &&
+        (!useStoredEne || SCorrelatorResponseMakerLegacyCstColumns::IsCstColumn(cstEnergy, *cstZ))
+      );
+      return (isJetGood && isCstGood);
+
+    }  // end 'IsValid(bool)'
+
+
+
     // ------------------------------------------------------------------------
     //! Translate legacy truth input into normal truth input
     // ------------------------------------------------------------------------
-    void SetInput(SCorrelatorResponseMakerTruthInput& input, optional<bool> isEmbed = nullopt) {
+    /*! Cst energies are either taken from the stored
+     *  branch (if useStoredEne) or computed from pt and
+     *  eta assuming the pion mass. Returns false (leaving
+     *  the input empty) if the branches aren't consistent.
+     */
+    bool SetInput(
+      SCorrelatorResponseMakerTruthInput& input,
+      optional<bool> isEmbed = nullopt,
+      const bool useStoredEne = false
+    ) {
 
       // make sure container is empty
       input.Reset();
+      if (!IsValid(useStoredEne)) return false;
 
       // set parton variables
       pair<Types::ParInfo, Types::ParInfo> partons;
@@ -398,46 +799,57 @@ namespace SColdQcdCorrelatorAnalysis {
       }
 
       // set jet variables
-      input.jets.resize( jetNumCst -> size() );
-      for (size_t iJet = 0; iJet < jetNumCst -> size(); iJet++) {
-        input.jets.at(iJet).SetJetID( jetID -> at(iJet) );
-        input.jets.at(iJet).SetNCsts( jetNumCst -> at(iJet) );
-        input.jets.at(iJet).SetEne( jetEnergy -> at(iJet) );
-        input.jets.at(iJet).SetPT( jetPt -> at(iJet) );
-        input.jets.at(iJet).SetEta( jetEta -> at(iJet) );
-        input.jets.at(iJet).SetPhi( jetPhi -> at(iJet) );
-        input.jets.at(iJet).SetArea( jetArea -> at(iJet) );
+      const size_t nJets = jetNumCst -> size();
+      input.jets.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+        input.jets[iJet].SetJetID( (*jetID)[iJet] );
+        input.jets[iJet].SetNCsts( (*jetNumCst)[iJet] );
+        input.jets[iJet].SetEne( (*jetEnergy)[iJet] );
+        input.jets[iJet].SetPT( (*jetPt)[iJet] );
+        input.jets[iJet].SetEta( (*jetEta)[iJet] );
+        input.jets[iJet].SetPhi( (*jetPhi)[iJet] );
+        input.jets[iJet].SetArea( (*jetArea)[iJet] );
       }  // end jet loop
 
-      // set cst variables
-      input.csts.resize( jetNumCst -> size() );
-      for (size_t iJet = 0; iJet < jetNumCst -> size(); iJet++) {
-
-        // loop over constituents
-        input.csts.at(iJet).resize( (cstZ -> at(iJet)).size() );
-        for (size_t iCst = 0; iCst < (cstZ -> at(iJet)).size(); iCst++) {
-          input.csts.at(iJet).at(iCst).SetCstID( (cstID -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetJetID( jetID -> at(iJet) );
-          input.csts.at(iJet).at(iCst).SetEmbedID( (cstEmbedID -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetZ( (cstZ -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetDR( (cstDr -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetPT( (cstPt -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetEta( (cstEta -> at(iJet)).at(iCst) );
-          input.csts.at(iJet).at(iCst).SetPhi( (cstPhi -> at(iJet)).at(iCst) );
-
-          // set cst. energy
-          ROOT::Math::PtEtaPhiMVector pCst(
-            input.csts.at(iJet).at(iCst).GetPT(),
-            input.csts.at(iJet).at(iCst).GetEta(),
-            input.csts.at(iJet).at(iCst).GetPhi(),
-            Const::MassPion()
-          );
-          input.csts.at(iJet).at(iCst).SetEne( pCst.E() );
-        }  // end cst loop
+      // set cst variables column by column
+      input.csts.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+
+        const size_t nCsts = (*cstZ)[iJet].size();
+        input.csts[iJet].resize(nCsts);
+
+        Types::CstInfo*       csts   = input.csts[iJet].data();
+        const unsigned int    id     = (*jetID)[iJet];
+        const vector<int>&    cstIDs = (*cstID)[iJet];
+        const vector<int>&    embed  = (*cstEmbedID)[iJet];
+        const vector<double>& z      = (*cstZ)[iJet];
+        const vector<double>& dr     = (*cstDr)[iJet];
+        const vector<double>& pt     = (*cstPt)[iJet];
+        const vector<double>& eta    = (*cstEta)[iJet];
+        const vector<double>& phi    = (*cstPhi)[iJet];
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetCstID( cstIDs[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetJetID( id );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetEmbedID( embed[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetZ( z[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetDR( dr[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetPT( pt[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetEta( eta[iCst] );
+        for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetPhi( phi[iCst] );
+        if (useStoredEne) {
+          const vector<double>& ene = (*cstEnergy)[iJet];
+          for (size_t iCst = 0; iCst < nCsts; iCst++) csts[iCst].SetEne( ene[iCst] );
+        }
       }  // end jet loop
-      return;
 
-    }  // end 'SetInput(SCorrelatorResponseMakerTruthInput&, optional<bool>)'
+      // if needed, compute cst energies for whole event
+      if (!useStoredEne) {
+        columns.Flatten(*cstPt, *cstEta, input.csts);
+        columns.CalcEnergies( Const::MassPion() );
+        columns.SetEnergies(input.csts);
+      }
+      return true;
+
+    }  // end 'SetInput(SCorrelatorResponseMakerTruthInput&, optional<bool>, bool)'
 
   };  // end SCorrelatorResponseMakerLegacyTruthInput
 
@@ -0,0 +1,139 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerIntersect.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Sorted-set intersection of constituent IDs
+ *  for the 'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERINTERSECT_H
+#define SCORRELATORRESPONSEMAKERINTERSECT_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Overlap of sorted constituent ID lists
+  // --------------------------------------------------------------------------
+  /*! Counts how many entries of a sorted list (lhs)
+   *  appear in another sorted list (rhs). The SIMD path
+   *  compares blocks of 4 IDs against each other in 4
+   *  rotations and needs lhs to have no duplicates;
+   *  otherwise, or if SSE2 isn't available, a scalar
+   *  merge-join is used.
+   */
+  struct SCorrelatorResponseMakerIntersect {
+
+    // ------------------------------------------------------------------------
+    //! Count with scalar merge-join
+    // ------------------------------------------------------------------------
+    static size_t CountScalar(
+      const int32_t* lhs,
+      const size_t nLhs,
+      const int32_t* rhs,
+      const size_t nRhs
+    ) {
+
+      size_t count = 0;
+      size_t iRhs  = 0;
+      for (size_t iLhs = 0; iLhs < nLhs; ++iLhs) {
+        while ((iRhs < nRhs) && (rhs[iRhs] < lhs[iLhs])) ++iRhs;
+        if (iRhs == nRhs) break;
+        if (rhs[iRhs] == lhs[iLhs]) ++count;
+      }
+      return count;
+
+    }  // end 'CountScalar(int32_t*, size_t, int32_t*, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Count with SIMD block comparison
+    // ------------------------------------------------------------------------
+    /*! Each lhs block accumulates a mask of which of its
+     *  IDs were found in any rhs block, which is counted
+     *  once the lhs block is done. Whatever is left over
+     *  at the end is finished with a merge-join.
+     */
+    static size_t CountSIMD(
+      const int32_t* lhs,
+      const size_t nLhs,
+      const int32_t* rhs,
+      const size_t nRhs
+    ) {
+
+#ifdef __SSE2__
+      size_t  count = 0;
+      size_t  iLhs  = 0;
+      size_t  iRhs  = 0;
+      __m128i found = _mm_setzero_si128();
+      while (((iLhs + 4) <= nLhs) && ((iRhs + 4) <= nRhs)) {
+
+        // compare all pairs in blocks
+        const __m128i lhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + iLhs));
+        const __m128i rhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + iRhs));
+        const __m128i rot1     = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(0, 3, 2, 1));
+        const __m128i rot2     = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(1, 0, 3, 2));
+        const __m128i rot3     = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(2, 1, 0, 3));
+        found = _mm_or_si128(found, _mm_cmpeq_epi32(lhsBlock, rhsBlock));
+        found = _mm_or_si128(found, _mm_cmpeq_epi32(lhsBlock, rot1));
+        found = _mm_or_si128(found, _mm_cmpeq_epi32(lhsBlock, rot2));
+        found = _mm_or_si128(found, _mm_cmpeq_epi32(lhsBlock, rot3));
+
+        // advance block(s) with smaller max
+        const int32_t lhsMax = lhs[iLhs + 3];
+        const int32_t rhsMax = rhs[iRhs + 3];
+        if (lhsMax <= rhsMax) {
+          count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(found)));
+          found  = _mm_setzero_si128();
+          iLhs  += 4;
+        }
+        if (rhsMax <= lhsMax) {
+          iRhs += 4;
+        }
+      }
+
+      // finish partially-searched lhs block and remainder
+      const int mask = _mm_movemask_ps(_mm_castsi128_ps(found));
+      for (size_t iRest = iLhs; iRest < nLhs; ++iRest) {
+        if (((iRest - iLhs) < 4) && ((mask >> (iRest - iLhs)) & 1)) {
+          ++count;
+          continue;
+        }
+        while ((iRhs < nRhs) && (rhs[iRhs] < lhs[iRest])) ++iRhs;
+        if ((iRhs < nRhs) && (rhs[iRhs] == lhs[iRest])) ++count;
+      }
+      return count;
+#else
+      return CountScalar(lhs, nLhs, rhs, nRhs);
+#endif
+
+    }  // end 'CountSIMD(int32_t*, size_t, int32_t*, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Count with best available method
+    // ------------------------------------------------------------------------
+    static size_t Count(
+      const int32_t* lhs,
+      const size_t nLhs,
+      const int32_t* rhs,
+      const size_t nRhs,
+      const bool isLhsUnique
+    ) {
+
+      const bool useSIMD = isLhsUnique && (nLhs >= 4) && (nRhs >= 4);
+      return useSIMD ? CountSIMD(lhs, nLhs, rhs, nRhs) : CountScalar(lhs, nLhs, rhs, nRhs);
+
+    }  // end 'Count(int32_t*, size_t, int32_t*, size_t, bool)'
+
+  };  // end SCorrelatorResponseMakerIntersect
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,241 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerKDTree.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Eta-phi k-d tree of reco constituents for
+ *  the 'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERKDTREE_H
+#define SCORRELATORRESPONSEMAKERKDTREE_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Reco constituent in k-d tree
+  // --------------------------------------------------------------------------
+  struct SCorrelatorResponseMakerCstPoint {
+
+    double  eta  = 0.;
+    double  phi  = 0.;
+    double  pt   = 0.;
+    int32_t iJet = -1;
+    int32_t iCst = -1;
+
+  };  // end SCorrelatorResponseMakerCstPoint
+
+
+
+  // --------------------------------------------------------------------------
+  //! Eta-phi k-d tree
+  // --------------------------------------------------------------------------
+  /*! Holds one or more trees, each stored implicitly
+   *  over a segment [offsets[i], offsets[i + 1]) of the
+   *  point array: the median of a segment along the
+   *  current axis (eta, then phi, alternating) is its
+   *  root, and the halves on either side are its
+   *  subtrees. Phi is periodic, so a query near the
+   *  edge of the phi range is repeated with its phi
+   *  shifted by +-2pi. Points can be marked as taken,
+   *  in which case they're skipped by queries.
+   */
+  struct SCorrelatorResponseMakerKDTree {
+
+    // points and segments
+    vector<SCorrelatorResponseMakerCstPoint> points;
+    vector<int32_t>                          offsets;
+    vector<uint8_t>                          isTaken;
+    vector<int32_t>                          taken;
+
+    // range of phi in tree
+    double phiMin = 0.;
+    double phiMax = 0.;
+
+    // ------------------------------------------------------------------------
+    //! Build trees from cached reco csts
+    // ------------------------------------------------------------------------
+    /*! If isPerJet, there is one tree per reco jet;
+     *  otherwise there is one tree for the whole event.
+     */
+    template <typename T> void Build(
+      const T& csts,
+      const SCorrelatorResponseMakerRecoCache& cache,
+      const bool isPerJet
+    ) {
+
+      Reset();
+
+      // collect good csts of good jets
+      phiMin = numeric_limits<double>::max();
+      phiMax = numeric_limits<double>::lowest();
+      offsets.push_back(0);
+      for (size_t iJet = 0; iJet < cache.GetNJets(); ++iJet) {
+        for (int32_t iGood = cache.offsets[iJet]; iGood < cache.offsets[iJet + 1]; ++iGood) {
+          const int32_t iCst = cache.cstIndices[iGood];
+          const auto&   cst  = csts[iJet][iCst];
+          points.push_back( {cst.GetEta(), cst.GetPhi(), cst.GetPT(), (int32_t) iJet, iCst} );
+          phiMin = min(phiMin, cst.GetPhi());
+          phiMax = max(phiMax, cst.GetPhi());
+        }
+        if (isPerJet) offsets.push_back(points.size());
+      }
+      if (!isPerJet) offsets.push_back(points.size());
+      isTaken.assign(points.size(), 0);
+
+      // arrange each segment into a tree
+      for (size_t iSeg = 0; (iSeg + 1) < offsets.size(); ++iSeg) {
+        BuildNode(offsets[iSeg], offsets[iSeg + 1], 0);
+      }
+      return;
+
+    }  // end 'Build(T&, SCorrelatorResponseMakerRecoCache&, bool)'
+
+    // ------------------------------------------------------------------------
+    //! Reset trees
+    // ------------------------------------------------------------------------
+    void Reset() {
+      points.clear();
+      offsets.clear();
+      isTaken.clear();
+      taken.clear();
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Mark a point as taken
+    // ------------------------------------------------------------------------
+    void Take(const int32_t iPoint) {
+      isTaken[iPoint] = 1;
+      taken.push_back(iPoint);
+      return;
+    }  // end 'Take(int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Release all taken points
+    // ------------------------------------------------------------------------
+    void Release() {
+      for (const int32_t iPoint : taken) {
+        isTaken[iPoint] = 0;
+      }
+      taken.clear();
+      return;
+    }  // end 'Release()'
+
+    // ------------------------------------------------------------------------
+    //! Find nearest untaken point in a segment
+    // ------------------------------------------------------------------------
+    /*! Only points with dr in drRange and with pt
+     *  in qtRange times the query pt, and for which
+     *  isAllowed(point) is true, are considered.
+     *  Returns the index of the point, or -1 if none.
+     */
+    template <typename F> int32_t FindNearest(
+      const size_t iSeg,
+      const double eta,
+      const double phi,
+      const double pt,
+      const pair<double, double>& drRange,
+      const pair<double, double>& qtRange,
+      F isAllowed
+    ) const {
+
+      const int32_t lo = offsets[iSeg];
+      const int32_t hi = offsets[iSeg + 1];
+      if (lo == hi) return -1;
+
+      // query shifted images of phi near the edges
+      int32_t best   = -1;
+      double  bestDr = drRange.second;
+      for (const double shift : {0., 2. * M_PI, -2. * M_PI}) {
+        const double phiQuery = phi + shift;
+        const bool   isNear   = ((phiQuery + drRange.second) >= phiMin) && ((phiQuery - drRange.second) <= phiMax);
+        if (!isNear) continue;
+        SearchNode(lo, hi, 0, eta, phiQuery, pt, drRange, qtRange, isAllowed, best, bestDr);
+      }
+      return best;
+
+    }  // end 'FindNearest(size_t, double, double, double, pair<double, double>&, pair<double, double>&, F)'
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Arrange [lo, hi) into a tree
+      // ----------------------------------------------------------------------
+      void BuildNode(const int32_t lo, const int32_t hi, const uint32_t depth) {
+
+        if ((hi - lo) < 2) return;
+
+        const int32_t mid = lo + ((hi - lo) / 2);
+        nth_element(
+          points.begin() + lo,
+          points.begin() + mid,
+          points.begin() + hi,
+          [depth](const SCorrelatorResponseMakerCstPoint& lhs, const SCorrelatorResponseMakerCstPoint& rhs) {
+            return (depth % 2 == 0) ? (lhs.eta < rhs.eta) : (lhs.phi < rhs.phi);
+          }
+        );
+        BuildNode(lo, mid, depth + 1);
+        BuildNode(mid + 1, hi, depth + 1);
+        return;
+
+      }  // end 'BuildNode(int32_t, int32_t, uint32_t)'
+
+      // ----------------------------------------------------------------------
+      //! Search [lo, hi) for nearest allowed point
+      // ----------------------------------------------------------------------
+      /*! n.b. phi is treated as flat here, periodicity
+       *  is handled by the caller
+       */
+      template <typename F> void SearchNode(
+        const int32_t lo,
+        const int32_t hi,
+        const uint32_t depth,
+        const double eta,
+        const double phi,
+        const double pt,
+        const pair<double, double>& drRange,
+        const pair<double, double>& qtRange,
+        F& isAllowed,
+        int32_t& best,
+        double& bestDr
+      ) const {
+
+        if (lo >= hi) return;
+
+        // check node
+        const int32_t                           mid   = lo + ((hi - lo) / 2);
+        const SCorrelatorResponseMakerCstPoint& point = points[mid];
+        const double                            dr    = std::hypot(point.eta - eta, point.phi - phi);
+        const double                            qt    = (pt > 0.) ? (point.pt / pt) : 0.;
+        const bool isCloser  = (dr < bestDr) || ((dr == bestDr) && (best < 0));
+        const bool isInRange = (dr >= drRange.first) && (qt >= qtRange.first) && (qt <= qtRange.second);
+        if (isCloser && isInRange && !isTaken[mid] && isAllowed(point)) {
+          best   = mid;
+          bestDr = dr;
+        }
+
+        // search near side, then far side if it could be closer
+        const double delta = (depth % 2 == 0) ? (eta - point.eta) : (phi - point.phi);
+        const bool   isLow = (delta < 0.);
+        SearchNode(isLow ? lo : mid + 1, isLow ? mid : hi, depth + 1, eta, phi, pt, drRange, qtRange, isAllowed, best, bestDr);
+        if (std::fabs(delta) <= bestDr) {
+          SearchNode(isLow ? mid + 1 : lo, isLow ? hi : mid, depth + 1, eta, phi, pt, drRange, qtRange, isAllowed, best, bestDr);
+        }
+        return;
+
+      }  // end 'SearchNode(...)'
+
+  };  // end SCorrelatorResponseMakerKDTree
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,221 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerMatches.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Match records for the 'SCorrelatorResponseMaker'
+ *  module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERMATCHES_H
+#define SCORRELATORRESPONSEMAKERMATCHES_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Match of a truth constituent to a reco constituent
+  // --------------------------------------------------------------------------
+  /*! Indices refer to the constituents of the truth/reco
+   *  jets of the parent jet match. The reco index is -1
+   *  if no match was found.
+   */
+  struct SCorrelatorResponseMakerCstMatch {
+
+    int32_t iTrueCst = -1;
+    int32_t iRecoCst = -1;
+
+    bool IsMatched() const {return (iRecoCst >= 0);}
+
+  };  // end SCorrelatorResponseMakerCstMatch
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match of a truth jet to a reco jet
+  // --------------------------------------------------------------------------
+  /*! Indices refer to the jets of the input event. The
+   *  good constituents of the truth jet and their reco
+   *  matches are stored as a contiguous range in the
+   *  constituent match list, starting at iFirstCst. The
+   *  reco index is -1 if no match was found.
+   */
+  struct SCorrelatorResponseMakerJetMatch {
+
+    int32_t  iTrueJet     = -1;
+    int32_t  iRecoJet     = -1;
+    int32_t  iRecoRecord  = -1;
+    uint32_t iFirstCst    = 0;
+    uint32_t nCsts        = 0;
+    double   fracCstMatch = 0.;
+    double   dr           = numeric_limits<double>::max();
+    double   qt           = numeric_limits<double>::max();
+
+    bool IsMatched() const {return (iRecoJet >= 0);}
+
+  };  // end SCorrelatorResponseMakerJetMatch
+
+
+
+  // --------------------------------------------------------------------------
+  //! Reco-side view of a reco jet
+  // --------------------------------------------------------------------------
+  /*! Filled for every good reco jet when reco-to-truth
+   *  matching is on. iTrueJet is the truth jet sharing
+   *  the largest fraction of the reco jet's good csts
+   *  (-1 if none), and the good reco csts with no truth
+   *  match (fakes) are stored as a contiguous range in
+   *  the fake cst list, starting at iFirstFake. A reco
+   *  jet unclaimed by the truth-side matching (i.e. not
+   *  the reco match of any truth jet record) is a fake,
+   *  even if it shares csts with a truth jet, in which
+   *  case iTrueJet is still set.
+   */
+  struct SCorrelatorResponseMakerRecoMatch {
+
+    int32_t  iRecoJet     = -1;
+    int32_t  iTrueJet     = -1;
+    uint32_t nCsts        = 0;
+    uint32_t iFirstFake   = 0;
+    uint32_t nFakes       = 0;
+    double   fracCstMatch = 0.;
+    bool     isFake       = true;
+
+    double GetPurity() const {return (nCsts > 0) ? (1. - ((double) nFakes / nCsts)) : 0.;}
+
+  };  // end SCorrelatorResponseMakerRecoMatch
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match records for an event
+  // --------------------------------------------------------------------------
+  struct SCorrelatorResponseMakerMatches {
+
+    // match records
+    vector<SCorrelatorResponseMakerJetMatch> jets;
+    vector<SCorrelatorResponseMakerCstMatch> csts;
+
+    // reco-side records
+    vector<SCorrelatorResponseMakerRecoMatch> recos;
+    vector<int32_t>                           fakeCsts;
+
+    // ------------------------------------------------------------------------
+    //! Reset records
+    // ------------------------------------------------------------------------
+    void Reset() {
+      jets.clear();
+      csts.clear();
+      recos.clear();
+      fakeCsts.clear();
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Start a record for a truth jet
+    // ------------------------------------------------------------------------
+    SCorrelatorResponseMakerJetMatch& AddJet(const int32_t iTrueJet) {
+      jets.emplace_back();
+      jets.back().iTrueJet  = iTrueJet;
+      jets.back().iFirstCst = csts.size();
+      return jets.back();
+    }  // end 'AddJet(int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Add a truth constituent to the most recent jet record
+    // ------------------------------------------------------------------------
+    void AddCst(const int32_t iTrueCst) {
+      csts.emplace_back();
+      csts.back().iTrueCst = iTrueCst;
+      ++jets.back().nCsts;
+      return;
+    }  // end 'AddCst(int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Start a reco-side record for a reco jet
+    // ------------------------------------------------------------------------
+    SCorrelatorResponseMakerRecoMatch& AddReco(const int32_t iRecoJet) {
+      recos.emplace_back();
+      recos.back().iRecoJet   = iRecoJet;
+      recos.back().iFirstFake = fakeCsts.size();
+      return recos.back();
+    }  // end 'AddReco(int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Add a fake cst to the most recent reco-side record
+    // ------------------------------------------------------------------------
+    void AddFake(const int32_t iRecoCst) {
+      fakeCsts.push_back(iRecoCst);
+      ++recos.back().nFakes;
+      return;
+    }  // end 'AddFake(int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of fake reco jets
+    // ------------------------------------------------------------------------
+    size_t GetNFakeJets() const {
+      return count_if(
+        recos.begin(),
+        recos.end(),
+        [](const SCorrelatorResponseMakerRecoMatch& reco) {return reco.isFake;}
+      );
+    }  // end 'GetNFakeJets()'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of truth jets with a reco match
+    // ------------------------------------------------------------------------
+    size_t GetNMatchedJets() const {
+      return count_if(
+        jets.begin(),
+        jets.end(),
+        [](const SCorrelatorResponseMakerJetMatch& jet) {return jet.IsMatched();}
+      );
+    }  // end 'GetNMatchedJets()'
+
+    // ------------------------------------------------------------------------
+    //! Select records of some jets from another set of records
+    // ------------------------------------------------------------------------
+    /*! Truth jet records passing isJetIn are copied along
+     *  with their cst matches. Reco-side records are
+     *  copied whole (so iRecoRecord stays valid), but only
+     *  fakes passing isFakeIn are kept as fakes.
+     */
+    template <typename FJ, typename FF> void Select(
+      const SCorrelatorResponseMakerMatches& all,
+      FJ isJetIn,
+      FF isFakeIn
+    ) {
+
+      Reset();
+      for (const SCorrelatorResponseMakerJetMatch& jet : all.jets) {
+        if (!isJetIn(jet)) continue;
+        jets.push_back(jet);
+        jets.back().iFirstCst = csts.size();
+        csts.insert(
+          csts.end(),
+          all.csts.begin() + jet.iFirstCst,
+          all.csts.begin() + jet.iFirstCst + jet.nCsts
+        );
+      }
+
+      recos    = all.recos;
+      fakeCsts = all.fakeCsts;
+      for (SCorrelatorResponseMakerRecoMatch& reco : recos) {
+        reco.isFake = reco.isFake && isFakeIn(reco);
+      }
+      return;
+
+    }  // end 'Select(SCorrelatorResponseMakerMatches&, FJ, FF)'
+
+  };  // end SCorrelatorResponseMakerMatches
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerMemory.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Allocation counters and memory sampling
+ *  for the 'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERMEMORY_H
+#define SCORRELATORRESPONSEMAKERMEMORY_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Process-wide allocation counters
+  // --------------------------------------------------------------------------
+  /*! Counters are only incremented if the allocator
+   *  hook (SCorrelatorResponseMakerAllocHook.cc) is
+   *  compiled in and is active, and if tracking has
+   *  been switched on.
+   */
+  struct SCorrelatorResponseMakerMemory {
+
+    // hook state
+    static inline atomic<bool> isHooked   {false};
+    static inline atomic<bool> isTracking {false};
+
+    // counters
+    static inline atomic<uint64_t> nAllocs {0};
+    static inline atomic<uint64_t> nBytes  {0};
+
+    // ------------------------------------------------------------------------
+    //! Count an allocation (called by hook)
+    // ------------------------------------------------------------------------
+    static void Count(const size_t size) {
+
+      if (!isTracking.load(memory_order_relaxed)) return;
+      nAllocs.fetch_add(1,    memory_order_relaxed);
+      nBytes.fetch_add(size, memory_order_relaxed);
+      return;
+
+    }  // end 'Count(size_t)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get current resident set size in bytes
+    // ------------------------------------------------------------------------
+    /*! Reads /proc/self/statm, whose second field is
+     *  the no. of resident pages. Returns 0 if the
+     *  file isn't available.
+     */
+    static uint64_t GetRSS() {
+
+      ifstream statm("/proc/self/statm");
+      if (!statm.good()) return 0;
+
+      uint64_t nPages    = 0;
+      uint64_t nResident = 0;
+      statm >> nPages >> nResident;
+      return nResident * sysconf(_SC_PAGESIZE);
+
+    }  // end 'GetRSS()'
+
+  };  // end SCorrelatorResponseMakerMemory
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -20,6 +20,15 @@ namespace SColdQcdCorrelatorAnalysis {
   // --------------------------------------------------------------------------
   //! Response tree output
   // --------------------------------------------------------------------------
+  /*! Each collection is written to its own fully split
+   *  branch, so every data member of the event, jet and
+   *  cst objects is streamed member-wise into its own
+   *  baskets and can be read on its own (e.g. only
+   *  "CstTrue.pt" and "CstReco.pt"). Since a nested
+   *  vector can't be split, the csts of all jets are
+   *  stored flat, with those of jet i at
+   *  [cstOffsets[i], cstOffsets[i + 1]).
+   */
   struct SCorrelatorResponseMakerOutput {
 
     // event level info
@@ -31,8 +40,25 @@ namespace SColdQcdCorrelatorAnalysis {
     vector<Types::JetInfo> jetRec;
 
     // constituent level info
-    vector<vector<Types::CstInfo>> cstGen;
-    vector<vector<Types::CstInfo>> cstRec;
+    //   - n.b. reco csts are parallel to truth csts
+    vector<uint32_t>       cstOffsets;
+    vector<Types::CstInfo> cstGen;
+    vector<Types::CstInfo> cstRec;
+
+    // reco-side info (if matching reco to truth)
+    //   - n.b. purity and fake cst offsets are parallel
+    //     to jetRec, fake jets are reco jets with no match
+    vector<double>         jetRecPurity;
+    vector<uint32_t>       cstRecFakeOffsets;
+    vector<Types::CstInfo> cstRecFake;
+    vector<Types::JetInfo> jetFake;
+    vector<double>         jetFakeOverlap;
+    vector<uint32_t>       cstFakeOffsets;
+    vector<Types::CstInfo> cstFake;
+
+    // pointers to collections attached to an existing tree
+    //   - n.b. each is boxed as a pointer of its own type
+    deque<shared_ptr<void>> attached;  //!
 
     // ------------------------------------------------------------------------
     //! Reset variables
@@ -42,18 +68,161 @@ namespace SColdQcdCorrelatorAnalysis {
       evtRec.Reset();
       jetGen.clear();
       jetRec.clear();
+      cstOffsets.clear();
       cstGen.clear();
       cstRec.clear();
+      jetRecPurity.clear();
+      cstRecFakeOffsets.clear();
+      cstRecFake.clear();
+      jetFake.clear();
+      jetFakeOverlap.clear();
+      cstFakeOffsets.clear();
+      cstFake.clear();
       return;
     }  // end 'Reset()'
 
     // ------------------------------------------------------------------------
     //! Set tree addresses
     // ------------------------------------------------------------------------
-    void SetTreeAddresses(TTree* tree) {
-      /* TODO fill in */
+    /*! Event branches hold one small object per entry,
+     *  so they get smaller baskets than the jet and cst
+     *  collections.
+     */
+    void SetTreeAddresses(
+      TTree* tree,
+      const bool doFakes = false,
+      const int32_t evtBasketSize = 16000,
+      const int32_t basketSize = 128000
+    ) {
+
+      tree -> Branch("EvtTrue.",   &evtGen,     evtBasketSize, 99);
+      tree -> Branch("EvtReco.",   &evtRec,     evtBasketSize, 99);
+      tree -> Branch("JetTrue.",   &jetGen,     basketSize,    99);
+      tree -> Branch("JetReco.",   &jetRec,     basketSize,    99);
+      tree -> Branch("CstOffsets", &cstOffsets, basketSize);
+      tree -> Branch("CstTrue.",   &cstGen,     basketSize,    99);
+      tree -> Branch("CstReco.",   &cstRec,     basketSize,    99);
+      if (doFakes) {
+        tree -> Branch("JetRecoPurity",      &jetRecPurity,      basketSize);
+        tree -> Branch("CstRecoFakeOffsets", &cstRecFakeOffsets, basketSize);
+        tree -> Branch("CstRecoFake.",       &cstRecFake,        basketSize, 99);
+        tree -> Branch("JetFake.",           &jetFake,           basketSize, 99);
+        tree -> Branch("JetFakeOverlap",     &jetFakeOverlap,    basketSize);
+        tree -> Branch("CstFakeOffsets",     &cstFakeOffsets,    basketSize);
+        tree -> Branch("CstFake.",           &cstFake,           basketSize, 99);
+      }
       return;
-    }  // end 'SetTreeAddresses(TTree*)'
+
+    }  // end 'SetTreeAddresses(TTree*, bool, int32_t, int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Set addresses on an existing tree (e.g. to append to it)
+    // ------------------------------------------------------------------------
+    void AttachTreeAddresses(TTree* tree, const bool doFakes = false) {
+
+      AttachObject(tree, "EvtTrue.",   evtGen);
+      AttachObject(tree, "EvtReco.",   evtRec);
+      AttachObject(tree, "JetTrue.",   jetGen);
+      AttachObject(tree, "JetReco.",   jetRec);
+      AttachObject(tree, "CstOffsets", cstOffsets);
+      AttachObject(tree, "CstTrue.",   cstGen);
+      AttachObject(tree, "CstReco.",   cstRec);
+      if (doFakes) {
+        AttachObject(tree, "JetRecoPurity",      jetRecPurity);
+        AttachObject(tree, "CstRecoFakeOffsets", cstRecFakeOffsets);
+        AttachObject(tree, "CstRecoFake.",       cstRecFake);
+        AttachObject(tree, "JetFake.",           jetFake);
+        AttachObject(tree, "JetFakeOverlap",     jetFakeOverlap);
+        AttachObject(tree, "CstFakeOffsets",     cstFakeOffsets);
+        AttachObject(tree, "CstFake.",           cstFake);
+      }
+      return;
+
+    }  // end 'AttachTreeAddresses(TTree*, bool)'
+
+    // ------------------------------------------------------------------------
+    //! Set address of an object branch on an existing tree
+    // ------------------------------------------------------------------------
+    /*! ROOT needs a pointer to a pointer to the object,
+     *  so a pointer of the right type is boxed on the
+     *  heap and kept for as long as the tree is in use.
+     */
+    template <typename T> void AttachObject(TTree* tree, const char* name, T& obj) {
+
+      shared_ptr<T*> box = make_shared<T*>( &obj );
+      attached.push_back(box);
+      tree -> SetBranchAddress(name, box.get());
+      return;
+
+    }  // end 'AttachObject(TTree*, char*, T&)'
+
+    // ------------------------------------------------------------------------
+    //! Fill output from match records
+    // ------------------------------------------------------------------------
+    /*! Reco jets/csts are stored parallel to their truth
+     *  counterparts, with default-constructed placeholders
+     *  where no match was found. If doFakes, reco-side
+     *  info is filled for every event, even those with no
+     *  good reco jets, so that it stays parallel too.
+     */
+    void GetOutput(
+      const SCorrelatorResponseMakerMatches& matches,
+      const SCorrelatorResponseMakerTruthInput& truth,
+      const SCorrelatorResponseMakerRecoInput& reco,
+      const bool doFakes = false
+    ) {
+
+      // placeholders for unmatched jets/csts
+      static const Types::JetInfo noJet;
+      static const Types::CstInfo noCst;
+
+      // set event info
+      evtGen = truth.evt;
+      evtRec = reco.evt;
+
+      // set jet and cst info
+      cstOffsets.push_back(0);
+      for (const SCorrelatorResponseMakerJetMatch& jet : matches.jets) {
+        jetGen.push_back( truth.jets[jet.iTrueJet] );
+        jetRec.push_back( jet.IsMatched() ? reco.jets[jet.iRecoJet] : noJet );
+        for (size_t iMatch = jet.iFirstCst; iMatch < jet.iFirstCst + jet.nCsts; ++iMatch) {
+          const SCorrelatorResponseMakerCstMatch& cst = matches.csts[iMatch];
+          cstGen.push_back( truth.csts[jet.iTrueJet][cst.iTrueCst] );
+          cstRec.push_back( cst.IsMatched() ? reco.csts[jet.iRecoJet][cst.iRecoCst] : noCst );
+        }
+        cstOffsets.push_back( cstGen.size() );
+      }
+
+      // set reco-side info if needed
+      if (!doFakes) return;
+      cstRecFakeOffsets.push_back(0);
+      for (const SCorrelatorResponseMakerJetMatch& jet : matches.jets) {
+        if (jet.iRecoRecord < 0) {
+          jetRecPurity.push_back(0.);
+          cstRecFakeOffsets.push_back( cstRecFake.size() );
+          continue;
+        }
+
+        const SCorrelatorResponseMakerRecoMatch& rec = matches.recos[jet.iRecoRecord];
+        jetRecPurity.push_back( rec.GetPurity() );
+        for (size_t iFake = rec.iFirstFake; iFake < rec.iFirstFake + rec.nFakes; ++iFake) {
+          cstRecFake.push_back( reco.csts[rec.iRecoJet][matches.fakeCsts[iFake]] );
+        }
+        cstRecFakeOffsets.push_back( cstRecFake.size() );
+      }
+      cstFakeOffsets.push_back(0);
+      for (const SCorrelatorResponseMakerRecoMatch& rec : matches.recos) {
+        if (!rec.isFake) continue;
+        jetFake.push_back( reco.jets[rec.iRecoJet] );
+        jetFakeOverlap.push_back( rec.fracCstMatch );
+        for (size_t iFake = rec.iFirstFake; iFake < rec.iFirstFake + rec.nFakes; ++iFake) {
+          cstFake.push_back( reco.csts[rec.iRecoJet][matches.fakeCsts[iFake]] );
+        }
+        cstFakeOffsets.push_back( cstFake.size() );
+      }
+      return;
+
+    }  // end 'GetOutput(SCorrelatorResponseMakerMatches&, SCorrelatorResponseMakerTruthInput&, SCorrelatorResponseMakerRecoInput&, bool)'
 
   };  // end SCorrelatorResponseMakerOutput
 
@@ -71,6 +240,7 @@ namespace SColdQcdCorrelatorAnalysis {
     pair<double, double> vtxX    = {numeric_limits<double>::max(), numeric_limits<double>::max()};
     pair<double, double> vtxY    = {numeric_limits<double>::max(), numeric_limits<double>::max()};
     pair<double, double> vtxZ    = {numeric_limits<double>::max(), numeric_limits<double>::max()};
+    int                  numMatchedJets = numeric_limits<int>::max();
 
     // jet level info
     pair<vector<uint32_t>, vector<uint32_t>> jetID;
@@ -90,6 +260,44 @@ namespace SColdQcdCorrelatorAnalysis {
     pair<vector<vector<double>>, vector<vector<double>>> cstEta;
     pair<vector<vector<double>>, vector<vector<double>>> cstPhi;
 
+    // reco-side info (if matching reco to truth)
+    //   - n.b. purity and fake csts are parallel to the
+    //     reco jets, fake jets are reco jets with no match
+    int                    numFakeJets = numeric_limits<int>::max();
+    vector<double>         jetRecoPurity;
+    vector<uint64_t>       jetRecoNumFakeCst;
+    vector<uint32_t>       fakeJetID;
+    vector<uint64_t>       fakeJetNumCst;
+    vector<double>         fakeJetEne;
+    vector<double>         fakeJetPt;
+    vector<double>         fakeJetEta;
+    vector<double>         fakeJetPhi;
+    vector<double>         fakeJetArea;
+    vector<double>         fakeJetOverlap;
+    vector<vector<int>>    fakeCstID;
+    vector<vector<double>> fakeCstEne;
+    vector<vector<double>> fakeCstPt;
+    vector<vector<double>> fakeCstEta;
+    vector<vector<double>> fakeCstPhi;
+
+    // pools of spare inner vectors of nested fields
+    SCorrelatorResponseMakerRecycler<int>    intRecycler;
+    SCorrelatorResponseMakerRecycler<double> doubleRecycler;
+
+    // pointers to vectors attached to an existing tree
+    //   - n.b. each is boxed as a pointer of its own type
+    deque<shared_ptr<void>> attached;
+
+    // reduced-precision copies of kinematic fields
+    //   - n.b. fields stored at less than double precision
+    //     are branched from these, and packed into them
+    //     from the double fields before each fill
+    map<string, SCorrelatorResponseMakerPrecision> precisions;
+    deque<vector<float>>                           packed;
+    deque<vector<vector<float>>>                   packedNested;
+    vector<function<void()>>                       packers;
+    map<const void*, void*>                        copyOf;
+
 
 
     // ------------------------------------------------------------------------
@@ -102,6 +310,7 @@ namespace SColdQcdCorrelatorAnalysis {
       vtxX    = {numeric_limits<double>::max(), numeric_limits<double>::max()};
       vtxY    = {numeric_limits<double>::max(), numeric_limits<double>::max()};
       vtxZ    = {numeric_limits<double>::max(), numeric_limits<double>::max()};
+      numMatchedJets = numeric_limits<int>::max();
       jetID.first.clear();
       jetID.second.clear();
       jetNumCst.first.clear();
@@ -116,20 +325,36 @@ namespace SColdQcdCorrelatorAnalysis {
       jetPhi.second.clear();
       jetArea.first.clear();
       jetArea.second.clear();
-      cstID.first.clear();
-      cstID.second.clear();
-      cstZ.first.clear();
-      cstZ.second.clear();
-      cstDr.first.clear();
-      cstDr.second.clear();
-      cstEne.first.clear();
-      cstEne.second.clear();
-      cstPt.first.clear();
-      cstPt.second.clear();
-      cstEta.first.clear();
-      cstEta.second.clear();
-      cstPhi.first.clear();
-      cstPhi.second.clear();
+      intRecycler.Recycle(cstID.first);
+      intRecycler.Recycle(cstID.second);
+      doubleRecycler.Recycle(cstZ.first);
+      doubleRecycler.Recycle(cstZ.second);
+      doubleRecycler.Recycle(cstDr.first);
+      doubleRecycler.Recycle(cstDr.second);
+      doubleRecycler.Recycle(cstEne.first);
+      doubleRecycler.Recycle(cstEne.second);
+      doubleRecycler.Recycle(cstPt.first);
+      doubleRecycler.Recycle(cstPt.second);
+      doubleRecycler.Recycle(cstEta.first);
+      doubleRecycler.Recycle(cstEta.second);
+      doubleRecycler.Recycle(cstPhi.first);
+      doubleRecycler.Recycle(cstPhi.second);
+      numFakeJets = numeric_limits<int>::max();
+      jetRecoPurity.clear();
+      jetRecoNumFakeCst.clear();
+      fakeJetID.clear();
+      fakeJetNumCst.clear();
+      fakeJetEne.clear();
+      fakeJetPt.clear();
+      fakeJetEta.clear();
+      fakeJetPhi.clear();
+      fakeJetArea.clear();
+      fakeJetOverlap.clear();
+      intRecycler.Recycle(fakeCstID);
+      doubleRecycler.Recycle(fakeCstEne);
+      doubleRecycler.Recycle(fakeCstPt);
+      doubleRecycler.Recycle(fakeCstEta);
+      doubleRecycler.Recycle(fakeCstPhi);
       return;
 
     }  // end 'Reset()'
@@ -139,7 +364,13 @@ namespace SColdQcdCorrelatorAnalysis {
     // ------------------------------------------------------------------------
     //! Set tree addresses
     // ------------------------------------------------------------------------
-    void SetTreeAddresses(TTree* tree) {
+    /*! Kinematic fields (keyed by their member name, e.g.
+     *  "jetPt" or "cstEta", which covers the true, reco
+     *  and fake branches) listed in precisions are stored
+     *  at the precision given; the rest are kept as
+     *  doubles. Precisions are set with ResetPacking().
+     */
+    void SetTreeAddresses(TTree* tree, const bool doFakes = false) {
 
       tree -> Branch("EvtTrueNumJets",     &numJets.first,  "EvtTrueNumJets/I");
       tree -> Branch("EvtRecoNumJets",     &numJets.second, "EvtRecoNumJets/I");
@@ -151,123 +382,605 @@ namespace SColdQcdCorrelatorAnalysis {
       tree -> Branch("EvtRecoVtxY",        &vtxY.second,    "EvtRecoVtxY/D");
       tree -> Branch("EvtTrueVtxZ",        &vtxZ.first,     "EvtTrueVtxZ/D");
       tree -> Branch("EvtRecoVtxZ",        &vtxZ.second,    "EvtRecoVtxZ/D");
+      tree -> Branch("EvtRecoNumMatchedJets", &numMatchedJets, "EvtRecoNumMatchedJets/I");
       tree -> Branch("JetTrueJetID",       &jetID.first);
       tree -> Branch("JetRecoJetID",       &jetID.second);
       tree -> Branch("JetTrueNumCst",      &jetNumCst.first);
       tree -> Branch("JetRecoNumCst",      &jetNumCst.second);
-      tree -> Branch("JetTrueEne",         &jetEne.first);
-      tree -> Branch("JetRecoEne",         &jetEne.second);
-      tree -> Branch("JetTruePt",          &jetPt.first);
-      tree -> Branch("JetRecoPt",          &jetPt.second);
-      tree -> Branch("JetTrueEta",         &jetEta.first);
-      tree -> Branch("JetRecoEta",         &jetEta.second);
-      tree -> Branch("JetTruePhi",         &jetPhi.first);
-      tree -> Branch("JetRecoPhi",         &jetPhi.second);
-      tree -> Branch("JetTrueArea",        &jetArea.first);
-      tree -> Branch("JetRecoArea",        &jetArea.second);
+      BranchField(tree, "JetTrueEne",         jetEne.first,   "jetEne");
+      BranchField(tree, "JetRecoEne",         jetEne.second,  "jetEne");
+      BranchField(tree, "JetTruePt",          jetPt.first,    "jetPt");
+      BranchField(tree, "JetRecoPt",          jetPt.second,   "jetPt");
+      BranchField(tree, "JetTrueEta",         jetEta.first,   "jetEta");
+      BranchField(tree, "JetRecoEta",         jetEta.second,  "jetEta");
+      BranchField(tree, "JetTruePhi",         jetPhi.first,   "jetPhi");
+      BranchField(tree, "JetRecoPhi",         jetPhi.second,  "jetPhi");
+      BranchField(tree, "JetTrueArea",        jetArea.first,  "jetArea");
+      BranchField(tree, "JetRecoArea",        jetArea.second, "jetArea");
       tree -> Branch("CstTrueCstID",       &cstID.first);
       tree -> Branch("CstRecoCstID",       &cstID.second);
-      tree -> Branch("CstTrueZ",           &cstZ.first);
-      tree -> Branch("CstRecoZ",           &cstZ.second);
-      tree -> Branch("CstTrueDr",          &cstDr.first);
-      tree -> Branch("CstRecoDr",          &cstDr.second);
-      tree -> Branch("CstRecoEne",         &cstEne.second);
-      tree -> Branch("CstTrueEne",         &cstEne.first);
-      tree -> Branch("CstTruePt",          &cstPt.first);
-      tree -> Branch("CstRecoPt",          &cstPt.second);
-      tree -> Branch("CstTrueEta",         &cstEta.first);
-      tree -> Branch("CstRecoEta",         &cstEta.second);
-      tree -> Branch("CstTruePhi",         &cstPhi.first);
-      tree -> Branch("CstRecoPhi",         &cstPhi.second);
+      BranchField(tree, "CstTrueZ",           cstZ.first,     "cstZ");
+      BranchField(tree, "CstRecoZ",           cstZ.second,    "cstZ");
+      BranchField(tree, "CstTrueDr",          cstDr.first,    "cstDr");
+      BranchField(tree, "CstRecoDr",          cstDr.second,   "cstDr");
+      BranchField(tree, "CstRecoEne",         cstEne.second,  "cstEne");
+      BranchField(tree, "CstTrueEne",         cstEne.first,   "cstEne");
+      BranchField(tree, "CstTruePt",          cstPt.first,    "cstPt");
+      BranchField(tree, "CstRecoPt",          cstPt.second,   "cstPt");
+      BranchField(tree, "CstTrueEta",         cstEta.first,   "cstEta");
+      BranchField(tree, "CstRecoEta",         cstEta.second,  "cstEta");
+      BranchField(tree, "CstTruePhi",         cstPhi.first,   "cstPhi");
+      BranchField(tree, "CstRecoPhi",         cstPhi.second,  "cstPhi");
+      if (doFakes) {
+        tree -> Branch("EvtRecoNumFakeJets", &numFakeJets, "EvtRecoNumFakeJets/I");
+        tree -> Branch("JetRecoPurity",      &jetRecoPurity);
+        tree -> Branch("JetRecoNumFakeCst",  &jetRecoNumFakeCst);
+        tree -> Branch("JetFakeJetID",       &fakeJetID);
+        tree -> Branch("JetFakeNumCst",      &fakeJetNumCst);
+        BranchField(tree, "JetFakeEne",         fakeJetEne,     "jetEne");
+        BranchField(tree, "JetFakePt",          fakeJetPt,      "jetPt");
+        BranchField(tree, "JetFakeEta",         fakeJetEta,     "jetEta");
+        BranchField(tree, "JetFakePhi",         fakeJetPhi,     "jetPhi");
+        BranchField(tree, "JetFakeArea",        fakeJetArea,    "jetArea");
+        tree -> Branch("JetFakeOverlap",     &fakeJetOverlap);
+        tree -> Branch("CstRecoFakeCstID",   &fakeCstID);
+        BranchField(tree, "CstRecoFakeEne",     fakeCstEne,     "cstEne");
+        BranchField(tree, "CstRecoFakePt",      fakeCstPt,      "cstPt");
+        BranchField(tree, "CstRecoFakeEta",     fakeCstEta,     "cstEta");
+        BranchField(tree, "CstRecoFakePhi",     fakeCstPhi,     "cstPhi");
+      }
       return;
 
-    }  // end 'SetTreeAddresses(TTree* tree)'
+    }  // end 'SetTreeAddresses(TTree*, bool)'
 
 
 
     // ------------------------------------------------------------------------
-    //! Translate normal output into legacy output
+    //! Set addresses on an existing tree (e.g. to append to it)
     // ------------------------------------------------------------------------
-    void GetOutput(const SCorrelatorResponseMakerOutput& output) {
+    void AttachTreeAddresses(TTree* tree, const bool doFakes = false) {
+
+      tree -> SetBranchAddress("EvtTrueNumJets",     &numJets.first);
+      tree -> SetBranchAddress("EvtRecoNumJets",     &numJets.second);
+      tree -> SetBranchAddress("EvtTrueNumChrgPars", &numTrks.first);
+      tree -> SetBranchAddress("EvtRecoNumChrgPars", &numTrks.second);
+      tree -> SetBranchAddress("EvtTrueVtxX",        &vtxX.first);
+      tree -> SetBranchAddress("EvtRecoVtxX",        &vtxX.second);
+      tree -> SetBranchAddress("EvtTrueVtxY",        &vtxY.first);
+      tree -> SetBranchAddress("EvtRecoVtxY",        &vtxY.second);
+      tree -> SetBranchAddress("EvtTrueVtxZ",        &vtxZ.first);
+      tree -> SetBranchAddress("EvtRecoVtxZ",        &vtxZ.second);
+      tree -> SetBranchAddress("EvtRecoNumMatchedJets", &numMatchedJets);
+      AttachVector(tree, "JetTrueJetID",       jetID.first);
+      AttachVector(tree, "JetRecoJetID",       jetID.second);
+      AttachVector(tree, "JetTrueNumCst",      jetNumCst.first);
+      AttachVector(tree, "JetRecoNumCst",      jetNumCst.second);
+      AttachField(tree, "JetTrueEne",         jetEne.first,   "jetEne");
+      AttachField(tree, "JetRecoEne",         jetEne.second,  "jetEne");
+      AttachField(tree, "JetTruePt",          jetPt.first,    "jetPt");
+      AttachField(tree, "JetRecoPt",          jetPt.second,   "jetPt");
+      AttachField(tree, "JetTrueEta",         jetEta.first,   "jetEta");
+      AttachField(tree, "JetRecoEta",         jetEta.second,  "jetEta");
+      AttachField(tree, "JetTruePhi",         jetPhi.first,   "jetPhi");
+      AttachField(tree, "JetRecoPhi",         jetPhi.second,  "jetPhi");
+      AttachField(tree, "JetTrueArea",        jetArea.first,  "jetArea");
+      AttachField(tree, "JetRecoArea",        jetArea.second, "jetArea");
+      AttachVector(tree, "CstTrueCstID",       cstID.first);
+      AttachVector(tree, "CstRecoCstID",       cstID.second);
+      AttachField(tree, "CstTrueZ",           cstZ.first,     "cstZ");
+      AttachField(tree, "CstRecoZ",           cstZ.second,    "cstZ");
+      AttachField(tree, "CstTrueDr",          cstDr.first,    "cstDr");
+      AttachField(tree, "CstRecoDr",          cstDr.second,   "cstDr");
+      AttachField(tree, "CstRecoEne",         cstEne.second,  "cstEne");
+      AttachField(tree, "CstTrueEne",         cstEne.first,   "cstEne");
+      AttachField(tree, "CstTruePt",          cstPt.first,    "cstPt");
+      AttachField(tree, "CstRecoPt",          cstPt.second,   "cstPt");
+      AttachField(tree, "CstTrueEta",         cstEta.first,   "cstEta");
+      AttachField(tree, "CstRecoEta",         cstEta.second,  "cstEta");
+      AttachField(tree, "CstTruePhi",         cstPhi.first,   "cstPhi");
+      AttachField(tree, "CstRecoPhi",         cstPhi.second,  "cstPhi");
+      if (doFakes) {
+        tree -> SetBranchAddress("EvtRecoNumFakeJets", &numFakeJets);
+        AttachVector(tree, "JetRecoPurity",     jetRecoPurity);
+        AttachVector(tree, "JetRecoNumFakeCst", jetRecoNumFakeCst);
+        AttachVector(tree, "JetFakeJetID",      fakeJetID);
+        AttachVector(tree, "JetFakeNumCst",     fakeJetNumCst);
+        AttachField(tree, "JetFakeEne",        fakeJetEne,     "jetEne");
+        AttachField(tree, "JetFakePt",         fakeJetPt,      "jetPt");
+        AttachField(tree, "JetFakeEta",        fakeJetEta,     "jetEta");
+        AttachField(tree, "JetFakePhi",        fakeJetPhi,     "jetPhi");
+        AttachField(tree, "JetFakeArea",       fakeJetArea,    "jetArea");
+        AttachVector(tree, "JetFakeOverlap",    fakeJetOverlap);
+        AttachVector(tree, "CstRecoFakeCstID",  fakeCstID);
+        AttachField(tree, "CstRecoFakeEne",    fakeCstEne,     "cstEne");
+        AttachField(tree, "CstRecoFakePt",     fakeCstPt,      "cstPt");
+        AttachField(tree, "CstRecoFakeEta",    fakeCstEta,     "cstEta");
+        AttachField(tree, "CstRecoFakePhi",    fakeCstPhi,     "cstPhi");
+      }
+      return;
 
-      // grab no.s of jets
-      const int64_t nTrueJets = output.jetGen.size();
-      const int64_t nRecoJets = output.jetRec.size();
+    }  // end 'AttachTreeAddresses(TTree*, bool)'
 
-      // set event info
-      numJets = make_pair( nTrueJets,                          nRecoJets );
-      numTrks = make_pair( output.evtGen.GetNChrgPar(),        output.evtRec.GetNTrks() );
-      vtxX    = make_pair( output.evtGen.GetPartonA().GetVX(), output.evtRec.GetVX() );
-      vtxY    = make_pair( output.evtGen.GetPartonA().GetVY(), output.evtRec.GetVY() );
-      vtxZ    = make_pair( output.evtGen.GetPartonA().GetVZ(), output.evtRec.GetVZ() );
-
-      // set true jet info
-      for (const Types::JetInfo& jet : output.jetGen) {
-        jetID.first.push_back( jet.GetJetID() );
-        jetNumCst.first.push_back( jet.GetNCsts() );
-        jetEne.first.push_back( jet.GetEne() );
-        jetPt.first.push_back( jet.GetPT() );
-        jetEta.first.push_back( jet.GetEta() );
-        jetPhi.first.push_back( jet.GetPhi() );
-        jetArea.first.push_back( jet.GetArea() );
+
+
+    // ------------------------------------------------------------------------
+    //! Set address of a vector branch on an existing tree
+    // ------------------------------------------------------------------------
+    /*! ROOT needs a pointer to a pointer to the vector,
+     *  so a pointer of the right type is boxed on the
+     *  heap and kept for as long as the tree is in use.
+     */
+    template <typename T> void AttachVector(TTree* tree, const char* name, T& vec) {
+
+      shared_ptr<T*> box = make_shared<T*>( &vec );
+      attached.push_back(box);
+      tree -> SetBranchAddress(name, box.get());
+      return;
+
+    }  // end 'AttachVector(TTree*, char*, T&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get keys of fields which can be stored at reduced precision
+    // ------------------------------------------------------------------------
+    static const vector<string>& GetFieldKeys() {
+
+      static const vector<string> keys = {
+        "jetEne",
+        "jetPt",
+        "jetEta",
+        "jetPhi",
+        "jetArea",
+        "cstZ",
+        "cstDr",
+        "cstEne",
+        "cstPt",
+        "cstEta",
+        "cstPhi"
+      };
+      return keys;
+
+    }  // end 'GetFieldKeys()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Check that precisions name known fields and can be packed to
+    // ------------------------------------------------------------------------
+    static bool CheckPrecisions(const map<string, SCorrelatorResponseMakerPrecision>& precisionsIn) {
+
+      const vector<string>& keys = GetFieldKeys();
+
+      bool isGood = true;
+      for (const auto& [key, precision] : precisionsIn) {
+        if (find(keys.begin(), keys.end(), key) == keys.end()) {
+          cerr << "PANIC: there's no field " << key << " to set the precision of!" << endl;
+          isGood = false;
+        }
+        if (!precision.IsValid()) {
+          cerr << "PANIC: precision of " << key << " packs to " << precision.nBits << " bits!" << endl;
+          isGood = false;
+        }
       }
+      return isGood;
+
+    }  // end 'CheckPrecisions(map<string, SCorrelatorResponseMakerPrecision>&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Reset reduced-precision copies for new trees
+    // ------------------------------------------------------------------------
+    /*! Must be called before setting the addresses of a
+     *  new set of trees (e.g. after rolling over), but
+     *  not between trees of the same set, as they share
+     *  the copies. Precisions must pass CheckPrecisions().
+     */
+    void ResetPacking(const map<string, SCorrelatorResponseMakerPrecision>& precisionsIn) {
+
+      precisions = precisionsIn;
+      packers.clear();
+      packed.clear();
+      packedNested.clear();
+      copyOf.clear();
+      return;
+
+    }  // end 'ResetPacking(map<string, SCorrelatorResponseMakerPrecision>&)'
+
 
-      // set reco jet info
-      for (const Types::JetInfo& jet : output.jetRec) {
-        jetID.second.push_back( jet.GetJetID() );
-        jetNumCst.second.push_back( jet.GetNCsts() );
-        jetEne.second.push_back( jet.GetEne() );
-        jetPt.second.push_back( jet.GetPT() );
-        jetEta.second.push_back( jet.GetEta() );
-        jetPhi.second.push_back( jet.GetPhi() );
-        jetArea.second.push_back( jet.GetArea() );
+
+    // ------------------------------------------------------------------------
+    //! Get precision of a field
+    // ------------------------------------------------------------------------
+    SCorrelatorResponseMakerPrecision GetPrecision(const string& key) const {
+
+      auto precision = precisions.find(key);
+      return (precision != precisions.end()) ? precision -> second : SCorrelatorResponseMakerPrecision();
+
+    }  // end 'GetPrecision(string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get field to store for a (nested) vector of doubles
+    // ------------------------------------------------------------------------
+    /*! Returns NULL if the field is kept as doubles, or
+     *  otherwise a float copy which is packed from it on
+     *  each call to Pack(). A field branched in several
+     *  trees gets only one copy.
+     */
+    template <typename T, typename P> P* GetStored(T& field, deque<P>& copies, const string& key) {
+
+      const SCorrelatorResponseMakerPrecision precision = GetPrecision(key);
+      if (precision.mode == SCorrelatorResponseMakerPrecision::Double) return NULL;
+
+      auto existing = copyOf.find(&field);
+      if (existing != copyOf.end()) return static_cast<P*>(existing -> second);
+
+      P& copy = copies.emplace_back();
+      packers.push_back([&field, &copy, precision]() {precision.Pack(field, copy);});
+      copyOf[&field] = &copy;
+      return &copy;
+
+    }  // end 'GetStored(T&, deque<P>&, string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Create branch for a kinematic field
+    // ------------------------------------------------------------------------
+    void BranchField(TTree* tree, const char* name, vector<double>& field, const string& key) {
+
+      vector<float>* stored = GetStored(field, packed, key);
+      if (stored) {
+        tree -> Branch(name, stored);
+      } else {
+        tree -> Branch(name, &field);
       }
+      return;
+
+    }  // end 'BranchField(TTree*, char*, vector<double>&, string&)'
+
+    void BranchField(TTree* tree, const char* name, vector<vector<double>>& field, const string& key) {
 
-      // set true cst info
-      cstID.first.resize( nTrueJets );
-      cstZ.first.resize( nTrueJets );
-      cstDr.first.resize( nTrueJets );
-      cstEne.first.resize( nTrueJets );
-      cstPt.first.resize( nTrueJets );
-      cstEta.first.resize( nTrueJets );
-      cstPhi.first.resize( nTrueJets );
-      for (size_t iTrueJet = 0; iTrueJet < output.cstGen.size(); ++iTrueJet) {
-        for (const Types::CstInfo& cst : output.cstGen[iTrueJet]) {
-          cstID.first.at(iTrueJet).push_back( cst.GetCstID() );
-          cstZ.first.at(iTrueJet).push_back( cst.GetZ() );
-          cstDr.first.at(iTrueJet).push_back( cst.GetDR() );
-          cstEne.first.at(iTrueJet).push_back( cst.GetEne() );
-          cstPt.first.at(iTrueJet).push_back( cst.GetPT() );
-          cstEta.first.at(iTrueJet).push_back( cst.GetEta() );
-          cstPhi.first.at(iTrueJet).push_back( cst.GetPhi() );
+      vector<vector<float>>* stored = GetStored(field, packedNested, key);
+      if (stored) {
+        tree -> Branch(name, stored);
+      } else {
+        tree -> Branch(name, &field);
+      }
+      return;
+
+    }  // end 'BranchField(TTree*, char*, vector<vector<double>>&, string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Set address of a kinematic field on an existing tree
+    // ------------------------------------------------------------------------
+    void AttachField(TTree* tree, const char* name, vector<double>& field, const string& key) {
+
+      vector<float>* stored = GetStored(field, packed, key);
+      if (stored) {
+        AttachVector(tree, name, *stored);
+      } else {
+        AttachVector(tree, name, field);
+      }
+      return;
+
+    }  // end 'AttachField(TTree*, char*, vector<double>&, string&)'
+
+    void AttachField(TTree* tree, const char* name, vector<vector<double>>& field, const string& key) {
+
+      vector<vector<float>>* stored = GetStored(field, packedNested, key);
+      if (stored) {
+        AttachVector(tree, name, *stored);
+      } else {
+        AttachVector(tree, name, field);
+      }
+      return;
+
+    }  // end 'AttachField(TTree*, char*, vector<vector<double>>&, string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Pack reduced-precision copies of fields
+    // ------------------------------------------------------------------------
+    void Pack() {
+
+      for (const function<void()>& pack : packers) {
+        pack();
+      }
+      return;
+
+    }  // end 'Pack()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Fill legacy output directly from match records
+    // ------------------------------------------------------------------------
+    /*! Reco jets/csts are stored parallel to their truth
+     *  counterparts, with default-constructed placeholders
+     *  where no match was found. If doFakes, reco-side
+     *  info is filled for every event, even those with no
+     *  good reco jets, so that it stays parallel too.
+     */
+    void GetOutput(
+      const SCorrelatorResponseMakerMatches& matches,
+      const SCorrelatorResponseMakerTruthInput& truth,
+      const SCorrelatorResponseMakerRecoInput& reco,
+      const bool doFakes = false
+    ) {
+
+      // placeholders for unmatched jets/csts
+      static const Types::JetInfo noJet;
+      static const Types::CstInfo noCst;
+
+      // grab no.s of jets
+      //   - n.b. reco jets are stored parallel to truth
+      //     jets (placeholders included), so there are as
+      //     many of each
+      const int64_t nJets = matches.jets.size();
+
+      // set event info
+      numJets = make_pair( nJets,                          nJets );
+      numTrks = make_pair( truth.evt.GetNChrgPar(),        reco.evt.GetNTrks() );
+      vtxX    = make_pair( truth.evt.GetPartonA().GetVX(), reco.evt.GetVX() );
+      vtxY    = make_pair( truth.evt.GetPartonA().GetVY(), reco.evt.GetVY() );
+      vtxZ    = make_pair( truth.evt.GetPartonA().GetVZ(), reco.evt.GetVZ() );
+      numMatchedJets = matches.GetNMatchedJets();
+
+      // prepare cst containers
+      intRecycler.Resize(cstID.first, nJets);
+      doubleRecycler.Resize(cstZ.first, nJets);
+      doubleRecycler.Resize(cstDr.first, nJets);
+      doubleRecycler.Resize(cstEne.first, nJets);
+      doubleRecycler.Resize(cstPt.first, nJets);
+      doubleRecycler.Resize(cstEta.first, nJets);
+      doubleRecycler.Resize(cstPhi.first, nJets);
+      intRecycler.Resize(cstID.second, nJets);
+      doubleRecycler.Resize(cstZ.second, nJets);
+      doubleRecycler.Resize(cstDr.second, nJets);
+      doubleRecycler.Resize(cstEne.second, nJets);
+      doubleRecycler.Resize(cstPt.second, nJets);
+      doubleRecycler.Resize(cstEta.second, nJets);
+      doubleRecycler.Resize(cstPhi.second, nJets);
+
+      // set jet and cst info
+      for (size_t iJet = 0; iJet < matches.jets.size(); ++iJet) {
+
+        const SCorrelatorResponseMakerJetMatch& jet = matches.jets[iJet];
+        AddJet( truth.jets[jet.iTrueJet], true );
+        AddJet( jet.IsMatched() ? reco.jets[jet.iRecoJet] : noJet, false );
+
+        for (size_t iMatch = jet.iFirstCst; iMatch < jet.iFirstCst + jet.nCsts; ++iMatch) {
+          const SCorrelatorResponseMakerCstMatch& cst = matches.csts[iMatch];
+          AddCst( truth.csts[jet.iTrueJet][cst.iTrueCst], iJet, true );
+          AddCst( cst.IsMatched() ? reco.csts[jet.iRecoJet][cst.iRecoCst] : noCst, iJet, false );
         }
       }
 
-      // set reco cst info
-      cstID.second.resize( nRecoJets );
-      cstZ.second.resize( nRecoJets );
-      cstDr.second.resize( nRecoJets );
-      cstEne.second.resize( nRecoJets );
-      cstPt.second.resize( nRecoJets );
-      cstEta.second.resize( nRecoJets );
-      cstPhi.second.resize( nRecoJets );
-      for (size_t iRecoJet = 0; iRecoJet < output.cstRec.size(); ++iRecoJet) {
-        for (const Types::CstInfo& cst : output.cstRec[iRecoJet]) {
-          cstID.second.at(iRecoJet).push_back( cst.GetCstID() );
-          cstZ.second.at(iRecoJet).push_back( cst.GetZ() );
-          cstDr.second.at(iRecoJet).push_back( cst.GetDR() );
-          cstEne.second.at(iRecoJet).push_back( cst.GetEne() );
-          cstPt.second.at(iRecoJet).push_back( cst.GetPT() );
-          cstEta.second.at(iRecoJet).push_back( cst.GetEta() );
-          cstPhi.second.at(iRecoJet).push_back( cst.GetPhi() );
+      // set reco-side info if needed
+      if (!doFakes) return;
+      numFakeJets = matches.GetNFakeJets();
+      intRecycler.Resize(fakeCstID, nJets);
+      doubleRecycler.Resize(fakeCstEne, nJets);
+      doubleRecycler.Resize(fakeCstPt, nJets);
+      doubleRecycler.Resize(fakeCstEta, nJets);
+      doubleRecycler.Resize(fakeCstPhi, nJets);
+      for (size_t iJet = 0; iJet < matches.jets.size(); ++iJet) {
+
+        const SCorrelatorResponseMakerJetMatch& jet = matches.jets[iJet];
+        if (jet.iRecoRecord < 0) {
+          jetRecoPurity.push_back(0.);
+          jetRecoNumFakeCst.push_back(0);
+          continue;
         }
+
+        const SCorrelatorResponseMakerRecoMatch& rec = matches.recos[jet.iRecoRecord];
+        jetRecoPurity.push_back( rec.GetPurity() );
+        jetRecoNumFakeCst.push_back( rec.nFakes );
+        for (size_t iFake = rec.iFirstFake; iFake < rec.iFirstFake + rec.nFakes; ++iFake) {
+          const Types::CstInfo& cst = reco.csts[rec.iRecoJet][matches.fakeCsts[iFake]];
+          fakeCstID[iJet].push_back( cst.GetCstID() );
+          fakeCstEne[iJet].push_back( cst.GetEne() );
+          fakeCstPt[iJet].push_back( cst.GetPT() );
+          fakeCstEta[iJet].push_back( cst.GetEta() );
+          fakeCstPhi[iJet].push_back( cst.GetPhi() );
+        }
+      }
+      for (const SCorrelatorResponseMakerRecoMatch& rec : matches.recos) {
+        if (!rec.isFake) continue;
+
+        const Types::JetInfo& jet = reco.jets[rec.iRecoJet];
+        fakeJetID.push_back( jet.GetJetID() );
+        fakeJetNumCst.push_back( jet.GetNCsts() );
+        fakeJetEne.push_back( jet.GetEne() );
+        fakeJetPt.push_back( jet.GetPT() );
+        fakeJetEta.push_back( jet.GetEta() );
+        fakeJetPhi.push_back( jet.GetPhi() );
+        fakeJetArea.push_back( jet.GetArea() );
+        fakeJetOverlap.push_back( rec.fracCstMatch );
       }
       return;
 
-    }  // end 'GetOutput(SCorrelatorResponseMakerOutput&)'
+    }  // end 'GetOutput(SCorrelatorResponseMakerMatches&, SCorrelatorResponseMakerTruthInput&, SCorrelatorResponseMakerRecoInput&, bool)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Add a jet to the truth (first) or reco (second) jet vectors
+    // ------------------------------------------------------------------------
+    void AddJet(const Types::JetInfo& jet, const bool isTruth) {
+
+      (isTruth ? jetID.first     : jetID.second).push_back( jet.GetJetID() );
+      (isTruth ? jetNumCst.first : jetNumCst.second).push_back( jet.GetNCsts() );
+      (isTruth ? jetEne.first    : jetEne.second).push_back( jet.GetEne() );
+      (isTruth ? jetPt.first     : jetPt.second).push_back( jet.GetPT() );
+      (isTruth ? jetEta.first    : jetEta.second).push_back( jet.GetEta() );
+      (isTruth ? jetPhi.first    : jetPhi.second).push_back( jet.GetPhi() );
+      (isTruth ? jetArea.first   : jetArea.second).push_back( jet.GetArea() );
+      return;
+
+    }  // end 'AddJet(Types::JetInfo&, bool)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Add a cst to the truth (first) or reco (second) cst vectors
+    // ------------------------------------------------------------------------
+    void AddCst(const Types::CstInfo& cst, const size_t iJet, const bool isTruth) {
+
+      (isTruth ? cstID.first  : cstID.second)[iJet].push_back( cst.GetCstID() );
+      (isTruth ? cstZ.first   : cstZ.second)[iJet].push_back( cst.GetZ() );
+      (isTruth ? cstDr.first  : cstDr.second)[iJet].push_back( cst.GetDR() );
+      (isTruth ? cstEne.first : cstEne.second)[iJet].push_back( cst.GetEne() );
+      (isTruth ? cstPt.first  : cstPt.second)[iJet].push_back( cst.GetPT() );
+      (isTruth ? cstEta.first : cstEta.second)[iJet].push_back( cst.GetEta() );
+      (isTruth ? cstPhi.first : cstPhi.second)[iJet].push_back( cst.GetPhi() );
+      return;
+
+    }  // end 'AddCst(Types::CstInfo&, size_t, bool)'
 
   };  // end SCorrelatorResponseMakerLegacyOutput
 
+
+  // --------------------------------------------------------------------------
+  //! Sparse response tree output
+  // --------------------------------------------------------------------------
+  /*! Holds only the match records of an event, as flat
+   *  arrays of indices into the input jet trees, rather
+   *  than copies of the matched jets and csts. The cst
+   *  matches of jet match i are at
+   *  [cstOffsets[i], cstOffsets[i + 1]). Reco indices
+   *  (and dr, qt) are -1 where no match was found.
+   *
+   *  Use 'SCorrelatorResponseMakerSparseReader' to join
+   *  the records back to the jet trees.
+   */
+  struct SCorrelatorResponseMakerSparseOutput {
+
+    // entries of event in input jet trees
+    uint64_t trueEntry = numeric_limits<uint64_t>::max();
+    uint64_t recoEntry = numeric_limits<uint64_t>::max();
+
+    // jet matches
+    vector<int32_t> iTrueJet;
+    vector<int32_t> iRecoJet;
+    vector<float>   fracCstMatch;
+    vector<float>   dr;
+    vector<float>   qt;
+
+    // cst matches
+    vector<uint32_t> cstOffsets;
+    vector<int32_t>  iTrueCst;
+    vector<int32_t>  iRecoCst;
+
+    // pointers to vectors attached to an existing tree
+    //   - n.b. each is boxed as a pointer of its own type
+    deque<shared_ptr<void>> attached;
+
+    // ------------------------------------------------------------------------
+    //! Reset variables
+    // ------------------------------------------------------------------------
+    void Reset() {
+      trueEntry = numeric_limits<uint64_t>::max();
+      recoEntry = numeric_limits<uint64_t>::max();
+      iTrueJet.clear();
+      iRecoJet.clear();
+      fracCstMatch.clear();
+      dr.clear();
+      qt.clear();
+      cstOffsets.clear();
+      iTrueCst.clear();
+      iRecoCst.clear();
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Set tree addresses
+    // ------------------------------------------------------------------------
+    void SetTreeAddresses(TTree* tree) {
+
+      tree -> Branch("TrueEntry",       &trueEntry, "TrueEntry/l");
+      tree -> Branch("RecoEntry",       &recoEntry, "RecoEntry/l");
+      tree -> Branch("JetTrueIndex",    &iTrueJet);
+      tree -> Branch("JetRecoIndex",    &iRecoJet);
+      tree -> Branch("JetFracCstMatch", &fracCstMatch);
+      tree -> Branch("JetDr",           &dr);
+      tree -> Branch("JetQt",           &qt);
+      tree -> Branch("CstOffsets",      &cstOffsets);
+      tree -> Branch("CstTrueIndex",    &iTrueCst);
+      tree -> Branch("CstRecoIndex",    &iRecoCst);
+      return;
+
+    }  // end 'SetTreeAddresses(TTree*)'
+
+    // ------------------------------------------------------------------------
+    //! Set addresses on an existing tree (e.g. to append to or read it)
+    // ------------------------------------------------------------------------
+    void AttachTreeAddresses(TTree* tree) {
+
+      tree -> SetBranchAddress("TrueEntry", &trueEntry);
+      tree -> SetBranchAddress("RecoEntry", &recoEntry);
+      AttachVector(tree, "JetTrueIndex",    iTrueJet);
+      AttachVector(tree, "JetRecoIndex",    iRecoJet);
+      AttachVector(tree, "JetFracCstMatch", fracCstMatch);
+      AttachVector(tree, "JetDr",           dr);
+      AttachVector(tree, "JetQt",           qt);
+      AttachVector(tree, "CstOffsets",      cstOffsets);
+      AttachVector(tree, "CstTrueIndex",    iTrueCst);
+      AttachVector(tree, "CstRecoIndex",    iRecoCst);
+      return;
+
+    }  // end 'AttachTreeAddresses(TTree*)'
+
+    // ------------------------------------------------------------------------
+    //! Set address of a vector branch on an existing tree
+    // ------------------------------------------------------------------------
+    template <typename T> void AttachVector(TTree* tree, const char* name, T& vec) {
+
+      shared_ptr<T*> box = make_shared<T*>( &vec );
+      attached.push_back(box);
+      tree -> SetBranchAddress(name, box.get());
+      return;
+
+    }  // end 'AttachVector(TTree*, char*, T&)'
+
+    // ------------------------------------------------------------------------
+    //! Fill sparse output from match records
+    // ------------------------------------------------------------------------
+    void GetOutput(
+      const SCorrelatorResponseMakerMatches& matches,
+      const uint64_t trueEntryIn,
+      const uint64_t recoEntryIn
+    ) {
+
+      trueEntry = trueEntryIn;
+      recoEntry = recoEntryIn;
+
+      cstOffsets.push_back(0);
+      for (const SCorrelatorResponseMakerJetMatch& jet : matches.jets) {
+        iTrueJet.push_back( jet.iTrueJet );
+        iRecoJet.push_back( jet.iRecoJet );
+        fracCstMatch.push_back( jet.fracCstMatch );
+        dr.push_back( jet.IsMatched() ? jet.dr : -1. );
+        qt.push_back( jet.IsMatched() ? jet.qt : -1. );
+        for (size_t iMatch = jet.iFirstCst; iMatch < jet.iFirstCst + jet.nCsts; ++iMatch) {
+          iTrueCst.push_back( matches.csts[iMatch].iTrueCst );
+          iRecoCst.push_back( matches.csts[iMatch].iRecoCst );
+        }
+        cstOffsets.push_back( iTrueCst.size() );
+      }
+      return;
+
+    }  // end 'GetOutput(SCorrelatorResponseMakerMatches&, uint64_t, uint64_t)'
+
+  };  // end SCorrelatorResponseMakerSparseOutput
+
 }  // end SColdQcdCorrelatorAnalysis namespace
 
 #endif
@@ -0,0 +1,109 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerPrecision.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Storage precision of output fields for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERPRECISION_H
+#define SCORRELATORRESPONSEMAKERPRECISION_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Precision an output field is stored at
+  // --------------------------------------------------------------------------
+  /*! Fields which aren't kept as doubles are stored as
+   *  floats, either as is (Float) or with only nBits of
+   *  the mantissa kept, the way ROOT packs Float16_t/
+   *  Double32_t without a range (Float16). The dropped
+   *  bits are zero, so they cost next to nothing once
+   *  compressed. Float16 needs nBits >= 1.
+   *
+   *  n.b. ROOT's ranged packing isn't offered, as the
+   *  quantized values would still be stored as full
+   *  floats and save no space.
+   */
+  struct SCorrelatorResponseMakerPrecision {
+
+    // storage modes
+    enum Mode {Double, Float, Float16};
+
+    // options
+    Mode     mode  = Double;
+    uint32_t nBits = 12;
+
+    // ------------------------------------------------------------------------
+    //! Check if precision can be packed to
+    // ------------------------------------------------------------------------
+    bool IsValid() const {
+      return (mode != Float16) || (nBits >= 1);
+    }  // end 'IsValid()'
+
+    // ------------------------------------------------------------------------
+    //! Pack a value
+    // ------------------------------------------------------------------------
+    float Pack(const double value) const {
+
+      if (mode != Float16) return value;
+
+      // round off mantissa
+      //   - n.b. rounds to nearest by adding half of the
+      //     lowest kept bit before dropping the rest
+      const uint32_t nDrop = 23 - std::min(nBits, (uint32_t) 23);
+      if (nDrop == 0) return value;
+
+      float    packed = value;
+      uint32_t bits   = 0;
+      memcpy(&bits, &packed, sizeof(bits));
+      bits += (1u << (nDrop - 1));
+      bits &= ~((1u << nDrop) - 1);
+      memcpy(&packed, &bits, sizeof(packed));
+      return packed;
+
+    }  // end 'Pack(double)'
+
+    // ------------------------------------------------------------------------
+    //! Pack a vector of values
+    // ------------------------------------------------------------------------
+    void Pack(const vector<double>& values, vector<float>& packed) const {
+
+      packed.resize(values.size());
+      for (size_t iVal = 0; iVal < values.size(); ++iVal) {
+        packed[iVal] = Pack(values[iVal]);
+      }
+      return;
+
+    }  // end 'Pack(vector<double>&, vector<float>&)'
+
+    // ------------------------------------------------------------------------
+    //! Pack a nested vector of values
+    // ------------------------------------------------------------------------
+    /*! Inner vectors are resized rather than replaced,
+     *  so they keep their capacity between events.
+     */
+    void Pack(const vector<vector<double>>& values, vector<vector<float>>& packed) const {
+
+      packed.resize(values.size());
+      for (size_t iVal = 0; iVal < values.size(); ++iVal) {
+        Pack(values[iVal], packed[iVal]);
+      }
+      return;
+
+    }  // end 'Pack(vector<vector<double>>&, vector<vector<float>>&)'
+
+  };  // end SCorrelatorResponseMakerPrecision
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
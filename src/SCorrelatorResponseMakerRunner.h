@@ -0,0 +1,275 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerRunner.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Runs several 'SCorrelatorResponseMaker' processes
+ *  in parallel on one node.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERRUNNER_H
+#define SCORRELATORRESPONSEMAKERRUNNER_H
+
+// module definition
+#include "SCorrelatorResponseMaker.h"
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Multi-process runner
+  // --------------------------------------------------------------------------
+  /*! Forks nProcs workers, each of which runs the usual
+   *  Init(), Analyze(), End() sequence on one shard of the
+   *  input into its own output file. Once all workers are
+   *  done, the shard outputs are merged into the configured
+   *  output file and the run statistics of each worker are
+   *  combined (unless the output is binned, in which case
+   *  the shards are kept as is). Since each worker is its
+   *  own process, no ROOT state is shared between them.
+   */
+  struct SCorrelatorResponseMakerRunner {
+
+    // options
+    uint32_t nProcs        = 1;
+    bool     keepShards    = false;
+    bool     inVerboseMode = true;
+
+    // combined statistics of workers
+    SCorrelatorResponseMakerStats stats;
+
+    // ------------------------------------------------------------------------
+    //! Run workers and merge their output
+    // ------------------------------------------------------------------------
+    bool Run(const SCorrelatorResponseMakerConfig& config) {
+
+      stats.Reset();
+      if (nProcs < 1) nProcs = 1;
+
+      // n.b. make sure nothing buffered is written twice
+      cout.flush();
+      cerr.flush();
+      fflush(NULL);
+
+      // launch workers
+      const auto     start = chrono::steady_clock::now();
+      vector<pid_t>  pids(nProcs, -1);
+      vector<int>    pipes(nProcs, -1);
+      vector<string> shards(nProcs);
+      for (uint32_t iProc = 0; iProc < nProcs; ++iProc) {
+
+        shards[iProc] = GetShardFileName(config.outFileName, iProc);
+
+        int fds[2];
+        if (::pipe(fds) != 0) {
+          cerr << "PANIC: couldn't create pipe for worker " << iProc << "!" << endl;
+          WaitForWorkers(pids, pipes);
+          return false;
+        }
+
+        pids[iProc] = ::fork();
+        if (pids[iProc] < 0) {
+          cerr << "PANIC: couldn't fork worker " << iProc << "!" << endl;
+          ::close(fds[0]);
+          ::close(fds[1]);
+          WaitForWorkers(pids, pipes);
+          return false;
+        }
+
+        // worker: process shard and report stats
+        if (pids[iProc] == 0) {
+          ::close(fds[0]);
+          const int status = RunWorker(config, iProc, shards[iProc], fds[1]);
+          ::close(fds[1]);
+          _exit(status);
+        }
+
+        ::close(fds[1]);
+        pipes[iProc] = fds[0];
+        if (inVerboseMode) {
+          cout << "    Launched worker " << iProc << " (pid " << pids[iProc] << ") writing to " << shards[iProc] << endl;
+        }
+      }
+
+      // wait for workers to finish
+      const bool isGood = WaitForWorkers(pids, pipes);
+      const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+      stats.loopTime = elapsed.count();
+      if (!isGood) {
+        cerr << "PANIC: at least one worker failed! Shard outputs are kept for inspection." << endl;
+        return false;
+      }
+
+      // binned or indexed shards can't be merged, so
+      // keep them
+      const bool isBinned  = (config.outBins.GetNBins() > 0);
+      const bool isIndexed = config.doJetIndex;
+      const bool isKept    = (isBinned || isIndexed);
+      if (isBinned) {
+        cerr << "WARNING: output is binned, so shards can't be merged! Shard outputs are kept as is." << endl;
+      }
+      if (isIndexed) {
+        cerr << "WARNING: output has jet indices, so shards can't be merged! Shard outputs are kept as is." << endl;
+      }
+
+      // merge shards
+      //   - n.b. the full input is only required if no
+      //     entry range was selected
+      if (!isKept) {
+        SCorrelatorResponseMakerMerger merger;
+        merger.requireTotal  = ((config.firstEntry == 0) && (config.nEntries == 0));
+        merger.inVerboseMode = inVerboseMode;
+        if (!merger.Merge(shards, config.outFileName)) {
+          return false;
+        }
+      }
+
+      // save combined statistics
+      if (config.saveStats && !isKept) {
+        TFile* file = new TFile(config.outFileName.data(), "update");
+        stats.Write(file);
+        file -> Close();
+        delete file;
+      }
+      if (inVerboseMode) {
+        stats.Print();
+      }
+
+      // clean up
+      if (!keepShards && !isKept) {
+        for (const string& shard : shards) {
+          remove(shard.data());
+        }
+      }
+      return true;
+
+    }  // end 'Run(SCorrelatorResponseMakerConfig&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get name of a worker's output file
+    // ------------------------------------------------------------------------
+    /*! e.g. "out.root" -> "out_proc0000.root"
+     */
+    static string GetShardFileName(const string& outFile, const uint32_t iProc) {
+
+      const size_t iDot = outFile.rfind(".root");
+      const string stem = outFile.substr(0, iDot);
+      const string ext  = (iDot != string::npos) ? outFile.substr(iDot) : "";
+
+      stringstream name;
+      name << stem << "_proc" << setw(4) << setfill('0') << iProc << ext;
+      return name.str();
+
+    }  // end 'GetShardFileName(string&, uint32_t)'
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Body of a worker process
+      // ----------------------------------------------------------------------
+      /*! Runs in the child, so the configuration is
+       *  adjusted here rather than in the parent.
+       */
+      int RunWorker(
+        const SCorrelatorResponseMakerConfig& config,
+        const uint32_t iProc,
+        const string& outFile,
+        const int fd
+      ) {
+
+        // select shard and disable options which
+        // would produce more than one file per worker
+        SCorrelatorResponseMakerConfig cfgWorker = config;
+        cfgWorker.outFileName        = outFile;
+        cfgWorker.iShard             = iProc;
+        cfgWorker.nShards            = nProcs;
+        cfgWorker.outMaxFileSize     = 0;
+        cfgWorker.outMaxEntries      = 0;
+        cfgWorker.saveStats          = false;
+        cfgWorker.nEvtsPerCheckpoint = 0;
+        cfgWorker.doResume           = false;
+
+        try {
+          SCorrelatorResponseMaker maker(cfgWorker);
+          if (!maker.Init()) return EXIT_FAILURE;
+          maker.Analyze();
+          maker.End();
+
+          const SCorrelatorResponseMakerStats result = maker.GetStats();
+          const char* bytes  = reinterpret_cast<const char*>(&result);
+          size_t      nBytes = sizeof(result);
+          while (nBytes > 0) {
+            const ssize_t nWritten = ::write(fd, bytes, nBytes);
+            if (nWritten <= 0) return EXIT_FAILURE;
+            bytes  += nWritten;
+            nBytes -= nWritten;
+          }
+        } catch (const exception& error) {
+          cerr << "PANIC: worker " << iProc << " threw: " << error.what() << endl;
+          return EXIT_FAILURE;
+        }
+
+        cout.flush();
+        cerr.flush();
+        return EXIT_SUCCESS;
+
+      }  // end 'RunWorker(SCorrelatorResponseMakerConfig&, uint32_t, string&, int)'
+
+
+
+      // ----------------------------------------------------------------------
+      //! Collect stats from and reap workers
+      // ----------------------------------------------------------------------
+      bool WaitForWorkers(const vector<pid_t>& pids, vector<int>& pipes) {
+
+        bool isGood = true;
+        for (size_t iProc = 0; iProc < pids.size(); ++iProc) {
+
+          if (pids[iProc] <= 0) continue;
+
+          // read stats
+          //   - n.b. read before waiting so a full pipe
+          //     can't block the worker
+          SCorrelatorResponseMakerStats result;
+          char*  bytes  = reinterpret_cast<char*>(&result);
+          size_t nBytes = sizeof(result);
+          while ((nBytes > 0) && (pipes[iProc] >= 0)) {
+            const ssize_t nRead = ::read(pipes[iProc], bytes, nBytes);
+            if (nRead <= 0) break;
+            bytes  += nRead;
+            nBytes -= nRead;
+          }
+          if (pipes[iProc] >= 0) {
+            ::close(pipes[iProc]);
+            pipes[iProc] = -1;
+          }
+
+          // and check exit status
+          int status = 0;
+          ::waitpid(pids[iProc], &status, 0);
+          const bool isDone = WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS) && (nBytes == 0);
+          if (isDone) {
+            stats.Add(result);
+          } else {
+            cerr << "WARNING: worker " << iProc << " (pid " << pids[iProc] << ") failed!" << endl;
+            isGood = false;
+          }
+        }
+        return isGood;
+
+      }  // end 'WaitForWorkers(vector<pid_t>&, vector<int>&)'
+
+  };  // end SCorrelatorResponseMakerRunner
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,294 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerShards.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Entry ranges and shard merging for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERSHARDS_H
+#define SCORRELATORRESPONSEMAKERSHARDS_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Range of input entries covered by an output file
+  // --------------------------------------------------------------------------
+  /*! Entries are [first, last), and total is the no.
+   *  of entries in the input. Written alongside the
+   *  response tree so that shards can be checked for
+   *  gaps or overlaps when merged.
+   */
+  struct SCorrelatorResponseMakerRange {
+
+    uint64_t first = 0;
+    uint64_t last  = 0;
+    uint64_t total = 0;
+
+    // ------------------------------------------------------------------------
+    //! Get range of shard i of n
+    // ------------------------------------------------------------------------
+    /*! Entries are split as evenly as possible, with
+     *  the first (total % n) shards getting one extra.
+     *  Returns false (leaving range untouched) if the
+     *  shard doesn't exist, i.e. if there are no shards
+     *  or i isn't less than n.
+     */
+    static bool GetShard(
+      const uint64_t total,
+      const uint32_t iShard,
+      const uint32_t nShards,
+      SCorrelatorResponseMakerRange& range
+    ) {
+
+      if (!IsShard(iShard, nShards)) return false;
+
+      const uint64_t base  = total / nShards;
+      const uint64_t extra = total % nShards;
+
+      range.first = (iShard * base) + min<uint64_t>(iShard, extra);
+      range.last  = range.first + base + ((iShard < extra) ? 1 : 0);
+      range.total = total;
+      return true;
+
+    }  // end 'GetShard(uint64_t, uint32_t, uint32_t, SCorrelatorResponseMakerRange&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Check if shard i of n exists
+    // ------------------------------------------------------------------------
+    static bool IsShard(const uint32_t iShard, const uint32_t nShards) {
+      return (nShards > 0) && (iShard < nShards);
+    }  // end 'IsShard(uint32_t, uint32_t)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Write range to a file
+    // ------------------------------------------------------------------------
+    void Write(TFile* file) const {
+
+      file -> cd();
+
+      uint64_t first = this -> first;
+      uint64_t last  = this -> last;
+      uint64_t total = this -> total;
+
+      TTree* tree = new TTree("EntryRange", "Range of input entries in response tree");
+      tree -> Branch("First", &first, "First/l");
+      tree -> Branch("Last",  &last,  "Last/l");
+      tree -> Branch("Total", &total, "Total/l");
+      tree -> Fill();
+      tree -> Write();
+      return;
+
+    }  // end 'Write(TFile*)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Read range from a file
+    // ------------------------------------------------------------------------
+    bool Read(TFile* file) {
+
+      TTree* tree = NULL;
+      file -> GetObject("EntryRange", tree);
+      if (!tree) return false;
+
+      tree -> SetBranchAddress("First", &first);
+      tree -> SetBranchAddress("Last",  &last);
+      tree -> SetBranchAddress("Total", &total);
+      tree -> GetEntry(0);
+      tree -> ResetBranchAddresses();
+      return true;
+
+    }  // end 'Read(TFile*)'
+
+  };  // end SCorrelatorResponseMakerRange
+
+
+
+  // --------------------------------------------------------------------------
+  //! Merger of shard outputs
+  // --------------------------------------------------------------------------
+  /*! Combines the response trees of several shards (or
+   *  output chunks) into one, ordered by input entry.
+   *  Baskets are copied without decompression ("fast"
+   *  cloning). Refuses to merge if any of the ranges
+   *  overlap, if any entries are missing, or if any
+   *  input is binned or has jet indices (as its
+   *  BinEntries or index rows would point to the wrong
+   *  entries of the merged trees).
+   */
+  struct SCorrelatorResponseMakerMerger {
+
+    // options
+    string treeName      = "ResponseTree";
+    bool   requireTotal  = true;
+    bool   inVerboseMode = true;
+
+    // ------------------------------------------------------------------------
+    //! Merge input files into output file
+    // ------------------------------------------------------------------------
+    bool Merge(const vector<string>& inFiles, const string& outFile) const {
+
+      // read ranges
+      vector<pair<SCorrelatorResponseMakerRange, string>> shards;
+      for (const string& inFile : inFiles) {
+
+        TFile* file = TFile::Open(inFile.data(), "read");
+        if (!file || file -> IsZombie()) {
+          cerr << "PANIC: couldn't open shard " << inFile << "! Aborting merge!" << endl;
+          return false;
+        }
+
+        SCorrelatorResponseMakerRange range;
+        const bool isRangeRead = range.Read(file);
+        const bool isBinned    = (file -> Get("ResponseBinIndex") != NULL);
+        const bool isIndexed   = (
+          (file -> Get("ResponseTrueJetIndex") != NULL) ||
+          (file -> Get("ResponseRecoJetIndex") != NULL)
+        );
+        file -> Close();
+        delete file;
+
+        if (!isRangeRead) {
+          cerr << "PANIC: no entry range in shard " << inFile << "! Aborting merge!" << endl;
+          return false;
+        }
+        if (isBinned) {
+          cerr << "PANIC: shard " << inFile << " is binned, and its bin entries can't be merged! Aborting merge!" << endl;
+          return false;
+        }
+        if (isIndexed) {
+          cerr << "PANIC: shard " << inFile << " has jet indices, and their output entries can't be merged! Aborting merge!" << endl;
+          return false;
+        }
+        shards.push_back( make_pair(range, inFile) );
+      }
+
+      // sort by first entry and check coverage
+      sort(
+        shards.begin(),
+        shards.end(),
+        [](const auto& lhs, const auto& rhs) {return (lhs.first.first < rhs.first.first);}
+      );
+      if (!IsCovered(shards)) return false;
+
+      // chain shards in entry order and clone baskets
+      TChain chain(treeName.data());
+      for (const auto& shard : shards) {
+        chain.Add(shard.second.data());
+        if (inVerboseMode) {
+          cout << "    Adding " << shard.second << ": entries [" << shard.first.first << ", " << shard.first.last << ")" << endl;
+        }
+      }
+
+      TFile* out = new TFile(outFile.data(), "recreate");
+      if (chain.Merge(out, 0, "fast keep") < 0) {
+        cerr << "PANIC: couldn't merge shards into " << outFile << "! Aborting merge!" << endl;
+        out -> Close();
+        delete out;
+        return false;
+      }
+
+      // and make sure every entry made it
+      //   - n.b. each shard has one entry per input entry
+      //     in its range
+      uint64_t nExpect = 0;
+      for (const auto& shard : shards) {
+        nExpect += shard.first.last - shard.first.first;
+      }
+
+      TTree* tree = NULL;
+      out -> GetObject(treeName.data(), tree);
+      const int64_t nMerged = tree ? tree -> GetEntries() : -1;
+      if ((nMerged < 0) || ((uint64_t) nMerged != nExpect)) {
+        cerr << "PANIC: merged " << nMerged << " entries but shards cover " << nExpect << "! Aborting merge!" << endl;
+        out -> Close();
+        delete out;
+        return false;
+      }
+
+      // record merged range
+      SCorrelatorResponseMakerRange merged;
+      merged.first = shards.front().first.first;
+      merged.last  = shards.back().first.last;
+      merged.total = shards.front().first.total;
+      merged.Write(out);
+      out -> Close();
+      delete out;
+
+      if (inVerboseMode) {
+        cout << "    Merged " << shards.size() << " shards into " << outFile << endl;
+      }
+      return true;
+
+    }  // end 'Merge(vector<string>&, string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Check that sorted ranges are contiguous and complete
+    // ------------------------------------------------------------------------
+    bool IsCovered(const vector<pair<SCorrelatorResponseMakerRange, string>>& shards) const {
+
+      if (shards.empty()) {
+        cerr << "PANIC: no shards to merge! Aborting merge!" << endl;
+        return false;
+      }
+
+      bool isGood = true;
+      for (size_t iShard = 1; iShard < shards.size(); ++iShard) {
+        const SCorrelatorResponseMakerRange& prev = shards[iShard - 1].first;
+        const SCorrelatorResponseMakerRange& curr = shards[iShard].first;
+        if (curr.first < prev.last) {
+          cerr << "PANIC: shards " << shards[iShard - 1].second << " and " << shards[iShard].second << " overlap!" << endl;
+          isGood = false;
+        } else if (curr.first > prev.last) {
+          cerr << "PANIC: entries [" << prev.last << ", " << curr.first << ") are missing!" << endl;
+          isGood = false;
+        }
+        if (curr.total != prev.total) {
+          cerr << "PANIC: shards " << shards[iShard - 1].second << " and " << shards[iShard].second << " are from different inputs!" << endl;
+          isGood = false;
+        }
+      }
+
+      // check full input is covered if needed
+      //   - n.b. outputs made in a Fun4All chain don't
+      //     know the total (it's left as 0), so there's
+      //     nothing to check against
+      const bool isTotalKnown = (shards.front().first.total > 0);
+      if (requireTotal && !isTotalKnown && inVerboseMode) {
+        cout << "    Total no. of input entries unknown, not checking it's covered." << endl;
+      }
+      if (requireTotal && isTotalKnown) {
+        if (shards.front().first.first != 0) {
+          cerr << "PANIC: entries [0, " << shards.front().first.first << ") are missing!" << endl;
+          isGood = false;
+        }
+        if (shards.back().first.last != shards.back().first.total) {
+          cerr << "PANIC: entries [" << shards.back().first.last << ", " << shards.back().first.total << ") are missing!" << endl;
+          isGood = false;
+        }
+      }
+      return isGood;
+
+    }  // end 'IsCovered(vector<pair<SCorrelatorResponseMakerRange, string>>&)'
+
+  };  // end SCorrelatorResponseMakerMerger
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
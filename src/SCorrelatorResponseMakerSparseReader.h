@@ -0,0 +1,209 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerSparseReader.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Reader joining sparse output of the
+ *  'SCorrelatorResponseMaker' module back to
+ *  its input jet trees.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERSPARSEREADER_H
+#define SCORRELATORRESPONSEMAKERSPARSEREADER_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Reads sparse output and joins it to the jet trees
+  // --------------------------------------------------------------------------
+  /*! Reading an entry only loads its match records; the
+   *  truth and reco jet trees (legacy or native) are
+   *  read the first time a jet or cst of that side is
+   *  asked for, so sides which aren't needed are never
+   *  read. If a jet tree entry is malformed, getters of
+   *  that side return NULL; 'JoinTruth()'/'JoinReco()'
+   *  can be called up front to skip such entries.
+   *
+   *  n.b. jets and csts returned are only valid until
+   *  the next entry is read.
+   */
+  struct SCorrelatorResponseMakerSparseReader {
+
+    // trees to read
+    TTree* sparseTree = NULL;
+    TTree* trueTree   = NULL;
+    TTree* recoTree   = NULL;
+
+    // records of current entry
+    SCorrelatorResponseMakerSparseOutput records;
+
+    // ------------------------------------------------------------------------
+    //! Set trees to read
+    // ------------------------------------------------------------------------
+    /*! If useStoredCstEne, cst energies of legacy jet
+     *  trees are taken from the CstEnergy branch.
+     */
+    void Init(TTree* sparse, TTree* truth, TTree* reco, const bool useStoredCstEne = false) {
+
+      sparseTree = sparse;
+      trueTree   = truth;
+      recoTree   = reco;
+      records.AttachTreeAddresses(sparseTree);
+
+      // set jet tree addresses according to format
+      m_useStoredCstEne = useStoredCstEne;
+      m_isLegacyTrue    = !SCorrelatorResponseMakerNativeTruthInput::IsNative(trueTree);
+      m_isLegacyReco    = !SCorrelatorResponseMakerNativeRecoInput::IsNative(recoTree);
+      if (m_isLegacyTrue) {
+        trueTree -> SetMakeClass(1);
+        m_trueLegacy.SetTreeAddresses(trueTree);
+      } else {
+        m_trueNative.SetTreeAddresses(trueTree);
+      }
+      if (m_isLegacyReco) {
+        recoTree -> SetMakeClass(1);
+        m_recoLegacy.SetTreeAddresses(recoTree);
+      } else {
+        m_recoNative.SetTreeAddresses(recoTree);
+      }
+      return;
+
+    }  // end 'Init(TTree*, TTree*, TTree*, bool)'
+
+    // ------------------------------------------------------------------------
+    //! Read match records of an entry
+    // ------------------------------------------------------------------------
+    int64_t GetEntry(const uint64_t iEntry) {
+      m_isTrueJoined = false;
+      m_isRecoJoined = false;
+      return sparseTree -> GetEntry(iEntry);
+    }  // end 'GetEntry(uint64_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of jet matches in entry
+    // ------------------------------------------------------------------------
+    size_t GetNJets() const {
+      return records.iTrueJet.size();
+    }  // end 'GetNJets()'
+
+    // ------------------------------------------------------------------------
+    //! Get no. of cst matches of a jet match
+    // ------------------------------------------------------------------------
+    size_t GetNCsts(const size_t iJet) const {
+      return records.cstOffsets[iJet + 1] - records.cstOffsets[iJet];
+    }  // end 'GetNCsts(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get truth jet of a jet match (NULL if unreadable)
+    // ------------------------------------------------------------------------
+    const Types::JetInfo* GetTrueJet(const size_t iJet) {
+      if (!JoinTruth()) return NULL;
+      return &m_truth.jets[records.iTrueJet[iJet]];
+    }  // end 'GetTrueJet(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get reco jet of a jet match (NULL if unmatched or unreadable)
+    // ------------------------------------------------------------------------
+    const Types::JetInfo* GetRecoJet(const size_t iJet) {
+      if (records.iRecoJet[iJet] < 0) return NULL;
+      if (!JoinReco()) return NULL;
+      return &m_reco.jets[records.iRecoJet[iJet]];
+    }  // end 'GetRecoJet(size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get truth cst of a cst match (NULL if unreadable)
+    // ------------------------------------------------------------------------
+    const Types::CstInfo* GetTrueCst(const size_t iJet, const size_t iCst) {
+      if (!JoinTruth()) return NULL;
+      const size_t iMatch = records.cstOffsets[iJet] + iCst;
+      return &m_truth.csts[records.iTrueJet[iJet]][records.iTrueCst[iMatch]];
+    }  // end 'GetTrueCst(size_t, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get reco cst of a cst match (NULL if unmatched or unreadable)
+    // ------------------------------------------------------------------------
+    const Types::CstInfo* GetRecoCst(const size_t iJet, const size_t iCst) {
+      const size_t iMatch = records.cstOffsets[iJet] + iCst;
+      if ((records.iRecoJet[iJet] < 0) || (records.iRecoCst[iMatch] < 0)) return NULL;
+      if (!JoinReco()) return NULL;
+      return &m_reco.csts[records.iRecoJet[iJet]][records.iRecoCst[iMatch]];
+    }  // end 'GetRecoCst(size_t, size_t)'
+
+    // ------------------------------------------------------------------------
+    //! Read truth jets of current entry if needed
+    // ------------------------------------------------------------------------
+    /*! Returns false if the truth entry couldn't be read
+     *  or is malformed.
+     */
+    bool JoinTruth() {
+
+      if (m_isTrueJoined) return m_isTrueGood;
+
+      m_isTrueJoined = true;
+      m_isTrueGood   = (trueTree -> GetEntry(records.trueEntry) > 0);
+      if (m_isTrueGood) {
+        m_isTrueGood = m_isLegacyTrue
+                     ? m_trueLegacy.SetInput(m_truth, nullopt, m_useStoredCstEne)
+                     : m_trueNative.SetInput(m_truth);
+      }
+      if (!m_isTrueGood) {
+        cerr << "WARNING: truth entry " << records.trueEntry << " is malformed!" << endl;
+      }
+      return m_isTrueGood;
+
+    }  // end 'JoinTruth()'
+
+    // ------------------------------------------------------------------------
+    //! Read reco jets of current entry if needed
+    // ------------------------------------------------------------------------
+    /*! Returns false if the reco entry couldn't be read
+     *  or is malformed.
+     */
+    bool JoinReco() {
+
+      if (m_isRecoJoined) return m_isRecoGood;
+
+      m_isRecoJoined = true;
+      m_isRecoGood   = (recoTree -> GetEntry(records.recoEntry) > 0);
+      if (m_isRecoGood) {
+        m_isRecoGood = m_isLegacyReco
+                     ? m_recoLegacy.SetInput(m_reco, m_useStoredCstEne)
+                     : m_recoNative.SetInput(m_reco);
+      }
+      if (!m_isRecoGood) {
+        cerr << "WARNING: reco entry " << records.recoEntry << " is malformed!" << endl;
+      }
+      return m_isRecoGood;
+
+    }  // end 'JoinReco()'
+
+    private:
+
+      // jet tree inputs
+      bool                                     m_useStoredCstEne = false;
+      bool                                     m_isLegacyTrue    = true;
+      bool                                     m_isLegacyReco    = true;
+      bool                                     m_isTrueJoined    = false;
+      bool                                     m_isRecoJoined    = false;
+      bool                                     m_isTrueGood      = false;
+      bool                                     m_isRecoGood      = false;
+      SCorrelatorResponseMakerTruthInput       m_truth;
+      SCorrelatorResponseMakerRecoInput        m_reco;
+      SCorrelatorResponseMakerLegacyTruthInput m_trueLegacy;
+      SCorrelatorResponseMakerLegacyRecoInput  m_recoLegacy;
+      SCorrelatorResponseMakerNativeTruthInput m_trueNative;
+      SCorrelatorResponseMakerNativeRecoInput  m_recoNative;
+
+  };  // end SCorrelatorResponseMakerSparseReader
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,374 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerStats.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Run statistics (per-stage timing, allocations,
+ *  throughput, memory) for the 'SCorrelatorResponseMaker'
+ *  module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERSTATS_H
+#define SCORRELATORRESPONSEMAKERSTATS_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Run statistics
+  // --------------------------------------------------------------------------
+  /*! Accumulates time spent and no. of calls for each
+   *  stage of the event loop, along with the no. of
+   *  bytes read from each input tree. If allocations
+   *  are tracked, also accumulates the no. of allocations
+   *  and bytes allocated in each stage and the peak
+   *  resident memory.
+   */
+  struct SCorrelatorResponseMakerStats {
+
+    // event loop stages
+    enum Stage {
+      ReadTrue,
+      ReadReco,
+      SetInput,
+      Batch,
+      ResetOut,
+      Match,
+      GetOutput,
+      Fill,
+      NStages
+    };
+
+    // per-stage accumulators
+    array<double,   NStages> time       {};
+    array<uint64_t, NStages> calls      {};
+    array<uint64_t, NStages> allocs     {};
+    array<uint64_t, NStages> allocBytes {};
+
+    // memory accumulators
+    bool     trackAllocs = false;
+    uint64_t nAllocs     = 0;
+    uint64_t peakRSS     = 0;
+
+    // throughput accumulators
+    uint64_t nEvts      = 0;
+    uint64_t nTrueBytes = 0;
+    uint64_t nRecoBytes = 0;
+    double   loopTime   = 0.;
+
+    // matching accumulators
+    uint64_t nCandidates = 0;
+    uint64_t nPruned     = 0;
+
+    // no. of events using each candidate index
+    array<uint64_t, SCorrelatorResponseMakerRecoCache::NIndices> nIndexEvts {};
+
+    // ------------------------------------------------------------------------
+    //! Get name of a stage
+    // ------------------------------------------------------------------------
+    static string GetStageName(const size_t stage) {
+
+      switch (stage) {
+        case ReadTrue:  return "ReadTrue";
+        case ReadReco:  return "ReadReco";
+        case SetInput:  return "SetInput";
+        case Batch:     return "Batch";
+        case ResetOut:  return "ResetOut";
+        case Match:     return "Match";
+        case GetOutput: return "GetOutput";
+        case Fill:      return "Fill";
+        default:        return "Unknown";
+      }
+
+    }  // end 'GetStageName(size_t)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Reset accumulators
+    // ------------------------------------------------------------------------
+    void Reset() {
+
+      time.fill(0.);
+      calls.fill(0);
+      allocs.fill(0);
+      allocBytes.fill(0);
+      nAllocs     = 0;
+      peakRSS     = 0;
+      nEvts       = 0;
+      nTrueBytes  = 0;
+      nRecoBytes  = 0;
+      loopTime    = 0.;
+      nCandidates = 0;
+      nPruned     = 0;
+      nIndexEvts.fill(0);
+      return;
+
+    }  // end 'Reset()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Add accumulators of another run
+    // ------------------------------------------------------------------------
+    /*! Used to combine the stats of several worker
+     *  processes. Peak memory is the largest of any one
+     *  worker (their peaks needn't coincide, so a sum
+     *  would overstate it), while the loop time is left
+     *  to the caller (i.e. the wall time of the whole
+     *  set of workers).
+     */
+    void Add(const SCorrelatorResponseMakerStats& other) {
+
+      for (size_t iStage = 0; iStage < NStages; ++iStage) {
+        time[iStage]       += other.time[iStage];
+        calls[iStage]      += other.calls[iStage];
+        allocs[iStage]     += other.allocs[iStage];
+        allocBytes[iStage] += other.allocBytes[iStage];
+      }
+      trackAllocs = trackAllocs || other.trackAllocs;
+      nAllocs     += other.nAllocs;
+      peakRSS     = max(peakRSS, other.peakRSS);
+      nEvts       += other.nEvts;
+      nTrueBytes  += other.nTrueBytes;
+      nRecoBytes  += other.nRecoBytes;
+      nCandidates += other.nCandidates;
+      nPruned     += other.nPruned;
+      for (size_t iIndex = 0; iIndex < nIndexEvts.size(); ++iIndex) {
+        nIndexEvts[iIndex] += other.nIndexEvts[iIndex];
+      }
+      return;
+
+    }  // end 'Add(SCorrelatorResponseMakerStats&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Sample resident memory and update peak
+    // ------------------------------------------------------------------------
+    void SampleRSS() {
+
+      peakRSS = max(peakRSS, SCorrelatorResponseMakerMemory::GetRSS());
+      return;
+
+    }  // end 'SampleRSS()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Print summary table
+    // ------------------------------------------------------------------------
+    void Print() const {
+
+      // get total time in stages
+      double sumTime = 0.;
+      for (const double stageTime : time) {
+        sumTime += stageTime;
+      }
+
+      cout << "    Run summary:\n"
+           << "      " << setw(10) << left << "stage"
+           << setw(12) << right << "calls"
+           << setw(14) << "time [s]"
+           << setw(14) << "per call [us]"
+           << setw(10) << "frac [%]";
+      if (trackAllocs) {
+        cout << setw(14) << "allocs/evt"
+             << setw(14) << "kB/evt";
+      }
+      cout << endl;
+      for (size_t iStage = 0; iStage < NStages; ++iStage) {
+        const double perCall = (calls[iStage] > 0) ? (1.e6 * time[iStage] / calls[iStage]) : 0.;
+        const double frac    = (sumTime > 0.) ? (100. * time[iStage] / sumTime) : 0.;
+        cout << "      " << setw(10) << left << GetStageName(iStage)
+             << setw(12) << right << calls[iStage]
+             << setw(14) << fixed << setprecision(3) << time[iStage]
+             << setw(14) << setprecision(2) << perCall
+             << setw(10) << setprecision(1) << frac;
+        if (trackAllocs) {
+          cout << setw(14) << setprecision(1) << ((nEvts > 0) ? (double) allocs[iStage] / nEvts : 0.)
+               << setw(14) << setprecision(2) << ((nEvts > 0) ? (allocBytes[iStage] / 1.e3) / nEvts : 0.);
+        }
+        cout << endl;
+      }
+
+      // print throughput
+      const double rate   = (loopTime > 0.) ? (nEvts / loopTime) : 0.;
+      const double trueMB = nTrueBytes / 1.e6;
+      const double recoMB = nRecoBytes / 1.e6;
+      cout << "      events processed = " << nEvts << " in " << setprecision(3) << loopTime << " s (" << setprecision(1) << rate << " evt/s)\n"
+           << "      truth bytes read = " << setprecision(2) << trueMB << " MB (" << ((loopTime > 0.) ? (trueMB / loopTime) : 0.) << " MB/s)\n"
+           << "      reco bytes read  = " << recoMB << " MB (" << ((loopTime > 0.) ? (recoMB / loopTime) : 0.) << " MB/s)"
+           << endl;
+
+      // print matching summary
+      const double fracPruned = (nCandidates > 0) ? (100. * nPruned / nCandidates) : 0.;
+      cout << "      candidate reco jets = " << nCandidates << ", pruned = " << nPruned << " (" << setprecision(1) << fracPruned << "%)" << endl;
+      cout << "      events per candidate index =";
+      for (size_t iIndex = 0; iIndex < nIndexEvts.size(); ++iIndex) {
+        cout << " " << SCorrelatorResponseMakerDispatcher::GetIndexName(iIndex) << ": " << nIndexEvts[iIndex];
+      }
+      cout << endl;
+
+      // print memory usage
+      if (trackAllocs) {
+        cout << "      peak resident memory = " << setprecision(1) << (peakRSS / 1.e6) << " MB" << endl;
+        if (SCorrelatorResponseMakerMemory::isHooked) {
+          cout << "      allocations per event = " << ((nEvts > 0) ? (double) nAllocs / nEvts : 0.) << endl;
+        } else {
+          cout << "      allocations per event = n/a (allocator hook not active)" << endl;
+        }
+      }
+      cout << defaultfloat;
+      return;
+
+    }  // end 'Print()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get summary as a JSON string
+    // ------------------------------------------------------------------------
+    string GetJson() const {
+
+      stringstream json;
+      json << "{\"nEvts\": " << nEvts
+           << ", \"nTrueBytes\": " << nTrueBytes
+           << ", \"nRecoBytes\": " << nRecoBytes
+           << ", \"loopTime\": " << loopTime
+           << ", \"nAllocs\": " << nAllocs
+           << ", \"peakRSS\": " << peakRSS
+           << ", \"nCandidates\": " << nCandidates
+           << ", \"nPruned\": " << nPruned
+           << ", \"nIndexEvts\": {";
+      for (size_t iIndex = 0; iIndex < nIndexEvts.size(); ++iIndex) {
+        json << ((iIndex > 0) ? ", " : "")
+             << "\"" << SCorrelatorResponseMakerDispatcher::GetIndexName(iIndex) << "\": " << nIndexEvts[iIndex];
+      }
+      json << "}"
+           << ", \"stages\": [";
+      for (size_t iStage = 0; iStage < NStages; ++iStage) {
+        json << ((iStage > 0) ? ", " : "")
+             << "{\"name\": \"" << GetStageName(iStage) << "\""
+             << ", \"calls\": " << calls[iStage]
+             << ", \"time\": " << time[iStage]
+             << ", \"allocs\": " << allocs[iStage]
+             << ", \"allocBytes\": " << allocBytes[iStage]
+             << "}";
+      }
+      json << "]}";
+      return json.str();
+
+    }  // end 'GetJson()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Write summary to a file as a tree and as JSON
+    // ------------------------------------------------------------------------
+    void Write(TFile* file) const {
+
+      file -> cd();
+
+      // one entry per stage
+      string   name;
+      uint64_t nCalls     = 0;
+      double   stageTime  = 0.;
+      uint64_t nStgAllocs = 0;
+      uint64_t nStgBytes  = 0;
+
+      TTree* tree = new TTree("StatsTree", "Per-stage timing of response maker");
+      tree -> Branch("Stage",      &name);
+      tree -> Branch("Calls",      &nCalls,     "Calls/l");
+      tree -> Branch("Time",       &stageTime,  "Time/D");
+      tree -> Branch("Allocs",     &nStgAllocs, "Allocs/l");
+      tree -> Branch("AllocBytes", &nStgBytes,  "AllocBytes/l");
+      for (size_t iStage = 0; iStage < NStages; ++iStage) {
+        name       = GetStageName(iStage);
+        nCalls     = calls[iStage];
+        stageTime  = time[iStage];
+        nStgAllocs = allocs[iStage];
+        nStgBytes  = allocBytes[iStage];
+        tree -> Fill();
+      }
+      tree -> Write();
+
+      // and full summary as json
+      TNamed json("StatsJson", GetJson().data());
+      json.Write();
+      return;
+
+    }  // end 'Write(TFile*)'
+
+  };  // end SCorrelatorResponseMakerStats
+
+
+
+  // --------------------------------------------------------------------------
+  //! Scoped stage timer
+  // --------------------------------------------------------------------------
+  /*! Adds time elapsed between construction and
+   *  destruction to the specified stage, along with
+   *  any allocations made in between if these are
+   *  being tracked. Does nothing if not enabled.
+   */
+  class SCorrelatorResponseMakerTimer {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting stats and stage to time
+      // ----------------------------------------------------------------------
+      SCorrelatorResponseMakerTimer(
+        SCorrelatorResponseMakerStats& stats,
+        const SCorrelatorResponseMakerStats::Stage stage,
+        const bool enable = true
+      ) : m_stats(stats), m_stage(stage), m_enable(enable) {
+
+        if (!m_enable) return;
+        if (m_stats.trackAllocs) {
+          m_allocs = SCorrelatorResponseMakerMemory::nAllocs;
+          m_bytes  = SCorrelatorResponseMakerMemory::nBytes;
+        }
+        m_start = chrono::steady_clock::now();
+
+      }  // end ctor(SCorrelatorResponseMakerStats&, Stage, bool)
+
+      // ----------------------------------------------------------------------
+      //! dtor
+      // ----------------------------------------------------------------------
+      ~SCorrelatorResponseMakerTimer() {
+
+        if (!m_enable) return;
+
+        const chrono::duration<double> elapsed = chrono::steady_clock::now() - m_start;
+        m_stats.time[m_stage] += elapsed.count();
+        ++m_stats.calls[m_stage];
+        if (m_stats.trackAllocs) {
+          m_stats.allocs[m_stage]     += SCorrelatorResponseMakerMemory::nAllocs - m_allocs;
+          m_stats.allocBytes[m_stage] += SCorrelatorResponseMakerMemory::nBytes - m_bytes;
+        }
+
+      }  // end dtor
+
+    private:
+
+      SCorrelatorResponseMakerStats&       m_stats;
+      SCorrelatorResponseMakerStats::Stage m_stage;
+      bool                                 m_enable;
+      chrono::steady_clock::time_point     m_start;
+      uint64_t                             m_allocs = 0;
+      uint64_t                             m_bytes  = 0;
+
+  };  // end SCorrelatorResponseMakerTimer
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
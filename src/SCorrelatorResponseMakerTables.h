@@ -0,0 +1,233 @@
+/// ---------------------------------------------------------------------------
+/*! \file   SCorrelatorResponseMakerTables.h
+ *  \author Derek Anderson
+ *  \date   10.18.2026
+ *
+ *  Per-event bookkeeping tables for the
+ *  'SCorrelatorResponseMaker' module.
+ */
+/// ---------------------------------------------------------------------------
+
+#ifndef SCORRELATORRESPONSEMAKERTABLES_H
+#define SCORRELATORRESPONSEMAKERTABLES_H
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // --------------------------------------------------------------------------
+  //! Flat truth <-> reco match table
+  // --------------------------------------------------------------------------
+  /*! Keeps track of which truth jets/csts are matched
+   *  to which reco jets/csts (and vice versa) in an
+   *  event. Constituents are addressed by a flat index,
+   *  the offset of their jet plus their index in that
+   *  jet, so that all lookups are O(1) array accesses.
+   *  Unmatched entries are -1. Storage is only grown,
+   *  never released, so that after the first few events
+   *  no allocations are made.
+   */
+  struct SCorrelatorResponseMakerMatchTable {
+
+    // jet-level tables
+    vector<int32_t> trueToRecoJet;
+    vector<int32_t> recoToTrueJet;
+
+    // cst offsets (size = no. of jets + 1)
+    vector<int32_t> trueOffsets;
+    vector<int32_t> recoOffsets;
+
+    // flat cst index -> jet index
+    vector<int32_t> trueCstToJet;
+    vector<int32_t> recoCstToJet;
+
+    // cst-level tables (flat index -> flat index)
+    vector<int32_t> trueToRecoCst;
+    vector<int32_t> recoToTrueCst;
+
+    // ------------------------------------------------------------------------
+    //! Size tables for an event
+    // ------------------------------------------------------------------------
+    template <typename T> void Init(const T& trueCsts, const T& recoCsts) {
+
+      InitSide(trueCsts, trueOffsets, trueCstToJet);
+      InitSide(recoCsts, recoOffsets, recoCstToJet);
+      trueToRecoJet.assign(trueCsts.size(), -1);
+      recoToTrueJet.assign(recoCsts.size(), -1);
+      trueToRecoCst.assign(trueCstToJet.size(), -1);
+      recoToTrueCst.assign(recoCstToJet.size(), -1);
+      return;
+
+    }  // end 'Init(T&, T&)'
+
+    // ------------------------------------------------------------------------
+    //! Reset tables
+    // ------------------------------------------------------------------------
+    void Reset() {
+      trueToRecoJet.clear();
+      recoToTrueJet.clear();
+      trueOffsets.clear();
+      recoOffsets.clear();
+      trueCstToJet.clear();
+      recoCstToJet.clear();
+      trueToRecoCst.clear();
+      recoToTrueCst.clear();
+      return;
+    }  // end 'Reset()'
+
+    // flat index getters
+    int32_t GetTrueFlat(const int32_t iJet, const int32_t iCst) const {return trueOffsets[iJet] + iCst;}
+    int32_t GetRecoFlat(const int32_t iJet, const int32_t iCst) const {return recoOffsets[iJet] + iCst;}
+
+    // match status getters
+    bool IsTrueJetMatched(const int32_t iJet) const {return (trueToRecoJet[iJet] >= 0);}
+    bool IsRecoJetMatched(const int32_t iJet) const {return (recoToTrueJet[iJet] >= 0);}
+    bool IsTrueCstMatched(const int32_t iJet, const int32_t iCst) const {return (trueToRecoCst[GetTrueFlat(iJet, iCst)] >= 0);}
+    bool IsRecoCstMatched(const int32_t iJet, const int32_t iCst) const {return (recoToTrueCst[GetRecoFlat(iJet, iCst)] >= 0);}
+
+    // ------------------------------------------------------------------------
+    //! Record a truth-reco jet match
+    // ------------------------------------------------------------------------
+    void MatchJets(const int32_t iTrueJet, const int32_t iRecoJet) {
+      trueToRecoJet[iTrueJet] = iRecoJet;
+      recoToTrueJet[iRecoJet] = iTrueJet;
+      return;
+    }  // end 'MatchJets(int32_t, int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Record a truth-reco cst match
+    // ------------------------------------------------------------------------
+    void MatchCsts(const int32_t iTrueJet, const int32_t iTrueCst, const int32_t iRecoJet, const int32_t iRecoCst) {
+      const int32_t trueFlat = GetTrueFlat(iTrueJet, iTrueCst);
+      const int32_t recoFlat = GetRecoFlat(iRecoJet, iRecoCst);
+      trueToRecoCst[trueFlat] = recoFlat;
+      recoToTrueCst[recoFlat] = trueFlat;
+      return;
+    }  // end 'MatchCsts(int32_t, int32_t, int32_t, int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get (jet, cst) indices of reco cst matched to a truth cst
+    // ------------------------------------------------------------------------
+    pair<int32_t, int32_t> GetRecoCst(const int32_t iTrueJet, const int32_t iTrueCst) const {
+      const int32_t recoFlat = trueToRecoCst[GetTrueFlat(iTrueJet, iTrueCst)];
+      if (recoFlat < 0) return {-1, -1};
+      const int32_t iRecoJet = recoCstToJet[recoFlat];
+      return {iRecoJet, recoFlat - recoOffsets[iRecoJet]};
+    }  // end 'GetRecoCst(int32_t, int32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Get (jet, cst) indices of truth cst matched to a reco cst
+    // ------------------------------------------------------------------------
+    pair<int32_t, int32_t> GetTrueCst(const int32_t iRecoJet, const int32_t iRecoCst) const {
+      const int32_t trueFlat = recoToTrueCst[GetRecoFlat(iRecoJet, iRecoCst)];
+      if (trueFlat < 0) return {-1, -1};
+      const int32_t iTrueJet = trueCstToJet[trueFlat];
+      return {iTrueJet, trueFlat - trueOffsets[iTrueJet]};
+    }  // end 'GetTrueCst(int32_t, int32_t)'
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Fill offsets and cst -> jet table for one side
+      // ----------------------------------------------------------------------
+      template <typename T> void InitSide(const T& csts, vector<int32_t>& offsets, vector<int32_t>& cstToJet) {
+
+        offsets.resize(csts.size() + 1);
+        offsets[0] = 0;
+        for (size_t iJet = 0; iJet < csts.size(); ++iJet) {
+          offsets[iJet + 1] = offsets[iJet] + csts[iJet].size();
+        }
+
+        cstToJet.resize(offsets.back());
+        for (size_t iJet = 0; iJet < csts.size(); ++iJet) {
+          fill(cstToJet.begin() + offsets[iJet], cstToJet.begin() + offsets[iJet + 1], iJet);
+        }
+        return;
+
+      }  // end 'InitSide(T&, vector<int32_t>&, vector<int32_t>&)'
+
+  };  // end SCorrelatorResponseMakerMatchTable
+
+
+
+  // --------------------------------------------------------------------------
+  //! Sparse truth x reco overlap matrix
+  // --------------------------------------------------------------------------
+  /*! Holds the no. of shared good csts for every truth-
+   *  reco jet pair that passed the jet dr/qt windows,
+   *  filled once per event while matching truth jets.
+   *  Entries are added in truth jet order, so the matrix
+   *  can be read by row (truth to reco) or scanned for
+   *  the best truth jet of each reco jet (reco to truth).
+   */
+  struct SCorrelatorResponseMakerOverlapMatrix {
+
+    // nonzero entries
+    struct Entry {
+      int32_t  iTrueJet = -1;
+      int32_t  iRecoJet = -1;
+      uint32_t nShared  = 0;
+    };
+    vector<Entry> entries;
+
+    // best truth jet of each reco jet
+    vector<int32_t> recoBestTrue;
+    vector<double>  recoBestFrac;
+
+    // ------------------------------------------------------------------------
+    //! Reset matrix
+    // ------------------------------------------------------------------------
+    void Reset() {
+      entries.clear();
+      recoBestTrue.clear();
+      recoBestFrac.clear();
+      return;
+    }  // end 'Reset()'
+
+    // ------------------------------------------------------------------------
+    //! Add an entry
+    // ------------------------------------------------------------------------
+    void Add(const int32_t iTrueJet, const int32_t iRecoJet, const uint32_t nShared) {
+      if (nShared == 0) return;
+      entries.push_back( {iTrueJet, iRecoJet, nShared} );
+      return;
+    }  // end 'Add(int32_t, int32_t, uint32_t)'
+
+    // ------------------------------------------------------------------------
+    //! Find best truth jet of each reco jet
+    // ------------------------------------------------------------------------
+    /*! The fraction is taken with respect to the no. of
+     *  good csts in the reco jet (from getNCsts(iJet)).
+     *  Ties go to the lowest truth jet index.
+     */
+    template <typename F> void FindRecoBest(
+      const size_t nRecoJets,
+      F getNCsts,
+      const pair<double, double>& fracRange
+    ) {
+
+      recoBestTrue.assign(nRecoJets, -1);
+      recoBestFrac.assign(nRecoJets, 0.);
+      for (const Entry& entry : entries) {
+        const size_t nCsts = getNCsts(entry.iRecoJet);
+        const double frac  = (nCsts > 0) ? ((double) entry.nShared / nCsts) : 0.;
+        const bool   isIn  = (frac > fracRange.first) && (frac <= fracRange.second);
+        if (isIn && (frac > recoBestFrac[entry.iRecoJet])) {
+          recoBestTrue[entry.iRecoJet] = entry.iTrueJet;
+          recoBestFrac[entry.iRecoJet] = frac;
+        }
+      }
+      return;
+
+    }  // end 'FindRecoBest(size_t, F, pair<double, double>&)'
+
+  };  // end SCorrelatorResponseMakerOverlapMatrix
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------